@@ -25,6 +25,7 @@
 #include <array>
 #include <atomic>
 #include <thread>
+#include <chrono>
 #include <mutex>
 #include <utility>
 #include <iostream>
@@ -35,8 +36,16 @@
 #include <numeric>
 #include <string_view>
 #include <variant>
+#include <tuple>
+#include <optional>
 #include <map>
+#include <list>
 #include <set>
+#include <execution>
+#include <charconv>
+#include <bit>
+#include <span>
+#include <stop_token>
 
 #ifdef BIO_PLATFORM_WINDOWS
 #define WIN32_LEAN_AND_MEAN
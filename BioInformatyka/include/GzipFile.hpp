@@ -0,0 +1,86 @@
+#pragma once
+#include "Core.hpp"
+
+struct FT_StreamRec_;
+
+/* BGZF block, an independent gzip member holding at most 64 KiB of data */
+struct BgzfBlock
+{
+	uint64_t CompressedOffset;
+	uint64_t UncompressedOffset;
+	uint32_t CompressedSize;
+	uint32_t UncompressedSize;
+};
+
+/*
+* gzip input over an already loaded (usually mapped) file, inflated by the zlib copy bundled with FreeType
+* BGZF files (bgzip, samtools) are split into blocks which are inflated in parallel and can be read piecewise
+* The file is never inflated whole, it's read front to back through a Stream or a range at a time
+*/
+class GzipFile
+{
+private:
+	NON_COPYABLE(GzipFile)
+public:
+	/* Front to back inflation, nothing but what the caller asked for is held */
+	class Stream
+	{
+	private:
+		NON_COPYABLE(Stream)
+	public:
+		explicit Stream(const GzipFile& file);
+		~Stream() noexcept;
+
+		/* Appends up to size bytes to the output and returns how many, BGZF files are read in whole blocks (at least one) */
+		size_t Read(std::string& output, const size_t size);
+
+		[[nodiscard]] inline bool IsAtEnd() const noexcept
+		{
+			return m_AtEnd;
+		}
+	private:
+		/* Source callback of the FreeType stream, its positions wrap at 4 GiB on Windows and are widened back here */
+		static unsigned long ReadSource(FT_StreamRec_* const source, const unsigned long position, unsigned char* const buffer, const unsigned long count);
+	private:
+		const GzipFile& m_File;
+		size_t m_NextBlock;		/* BGZF only */
+
+		/* Other files only, the source serves the compressed bytes to the inflating stream */
+		std::unique_ptr<FT_StreamRec_> m_Source;
+		std::unique_ptr<FT_StreamRec_> m_Inflater;
+		uint64_t m_SourcePosition;
+
+		uint64_t m_InflatedSize;
+		bool m_AtEnd;
+	};
+public:
+	/* The compressed data has to outlive the object */
+	explicit GzipFile(const std::string_view compressed);
+	~GzipFile() noexcept = default;
+
+	[[nodiscard]] static bool IsCompressed(const std::string_view data) noexcept;
+
+	/* Bytes [begin, end), BGZF files only inflate the blocks overlapping the range, other files everything in front of it */
+	[[nodiscard]] std::string_view Read(const uint64_t begin, const uint64_t end, std::string& buffer) const;
+
+	/* Exact for BGZF, the trailer size (modulo 4 GiB) otherwise */
+	[[nodiscard]] uint64_t GetSize() const noexcept;
+
+	[[nodiscard]] inline bool IsBlocked() const noexcept
+	{
+		return !m_Blocks.empty();
+	}
+
+	[[nodiscard]] inline const std::vector<BgzfBlock>& GetBlocks() const noexcept
+	{
+		return m_Blocks;
+	}
+private:
+	/* Empty when the first member isn't a BGZF block */
+	[[nodiscard]] static std::vector<BgzfBlock> IndexBlocks(const std::string_view data);
+
+	void InflateBlocks(const std::vector<BgzfBlock>::const_iterator first, const std::vector<BgzfBlock>::const_iterator last, char* const output) const;
+private:
+	std::string_view m_Compressed;
+	std::vector<BgzfBlock> m_Blocks;
+};
\ No newline at end of file
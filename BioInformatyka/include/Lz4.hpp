@@ -0,0 +1,27 @@
+#pragma once
+#include "Core.hpp"
+
+/*
+* LZ4 block format (without the frame), compatible with the reference decoder
+* Blocks don't reference each other, callers split their data to (de)compress the pieces in parallel
+*/
+namespace Lz4
+{
+	/* Largest compressed size of a block, incompressible data only gains the literal length bytes */
+	[[nodiscard]] constexpr size_t CompressBound(const size_t size) noexcept
+	{
+		return size + size / 255U + 16U;
+	}
+
+	/* Largest size a compressed block can expand to, every length byte adds at most 255 bytes of output */
+	[[nodiscard]] constexpr size_t DecompressBound(const size_t size) noexcept
+	{
+		return size * 255U;
+	}
+
+	/* Appends the compressed block to the output */
+	void Compress(const std::string_view input, std::string& output);
+
+	/* Malformed input (or any size other than outputSize) throws */
+	void Decompress(const std::string_view input, char* const output, const size_t outputSize);
+}
\ No newline at end of file
@@ -0,0 +1,29 @@
+#pragma once
+#include "Core.hpp"
+
+/* Read-only mapping of a whole file, pages are faulted in by the OS on first access */
+class MappedFile
+{
+private:
+	NON_COPYABLE(MappedFile)
+public:
+	/* With allowAppends other handles may write to the file, only bytes past the mapped size may change */
+	explicit MappedFile(const std::filesystem::path& path, const bool allowAppends = false);
+	~MappedFile() noexcept;
+
+	[[nodiscard]] inline std::string_view GetView() const noexcept
+	{
+		return { m_Data, m_Size };
+	}
+
+	[[nodiscard]] inline size_t GetSize() const noexcept
+	{
+		return m_Size;
+	}
+private:
+	const char* m_Data;
+	size_t m_Size;
+
+	void* m_FileHandle;
+	void* m_MappingHandle;
+};
\ No newline at end of file
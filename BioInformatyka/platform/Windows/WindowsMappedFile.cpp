@@ -0,0 +1,72 @@
+#ifdef BIO_PLATFORM_WINDOWS
+#include "MappedFile.hpp"
+
+MappedFile::MappedFile(const std::filesystem::path& path, const bool allowAppends)
+	:
+	m_Data(nullptr),
+	m_Size(0U),
+	m_FileHandle(INVALID_HANDLE_VALUE),
+	m_MappingHandle(nullptr)
+{
+	m_FileHandle = CreateFileW(
+		path.c_str(),
+		GENERIC_READ,
+		FILE_SHARE_READ | (allowAppends ? FILE_SHARE_WRITE : 0),
+		nullptr,
+		OPEN_EXISTING,
+		FILE_ATTRIBUTE_NORMAL | FILE_FLAG_SEQUENTIAL_SCAN,
+		nullptr);
+
+	BIO_UNLIKELY
+	if (m_FileHandle == INVALID_HANDLE_VALUE)
+		THROW_EXCEPTION("Failed to open file");
+
+	LARGE_INTEGER fileSize{};
+
+	BIO_UNLIKELY
+	if (!GetFileSizeEx(m_FileHandle, &fileSize))
+	{
+		CloseHandle(m_FileHandle);
+		THROW_EXCEPTION("Failed to query file size");
+	}
+
+	m_Size = static_cast<size_t>(fileSize.QuadPart);
+
+	/* Empty files can't be mapped, an empty view is returned instead */
+	BIO_UNLIKELY
+	if (m_Size == 0U)
+		return;
+
+	m_MappingHandle = CreateFileMappingW(m_FileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+
+	BIO_UNLIKELY
+	if (!m_MappingHandle)
+	{
+		CloseHandle(m_FileHandle);
+		THROW_EXCEPTION("Failed to map file");
+	}
+
+	m_Data = static_cast<const char*>(MapViewOfFile(m_MappingHandle, FILE_MAP_READ, 0, 0, 0));
+
+	BIO_UNLIKELY
+	if (!m_Data)
+	{
+		CloseHandle(m_MappingHandle);
+		CloseHandle(m_FileHandle);
+		THROW_EXCEPTION("Failed to map view of file");
+	}
+}
+
+MappedFile::~MappedFile() noexcept
+{
+	if (m_Data)
+		UnmapViewOfFile(m_Data);
+
+	if (m_MappingHandle)
+		CloseHandle(m_MappingHandle);
+
+	if (m_FileHandle != INVALID_HANDLE_VALUE)
+		CloseHandle(m_FileHandle);
+}
+
+#endif
\ No newline at end of file
@@ -0,0 +1,326 @@
+#include "GzipFile.hpp"
+#include <ft2build.h>
+#include FT_GZIP_H
+#include FT_SYSTEM_H
+
+/* FreeType only needs an allocator to inflate, no library instance is created */
+static FT_MemoryRec_ g_InflateMemory
+{
+	.user{ nullptr },
+	.alloc{ [](FT_Memory, const long size) -> void* { return std::malloc(static_cast<size_t>(size)); } },
+	.free{ [](FT_Memory, void* const block) { std::free(block); } },
+	.realloc{ [](FT_Memory, long, const long newSize, void* const block) -> void* { return std::realloc(block, static_cast<size_t>(newSize)); } }
+};
+
+/* Fixed gzip header, extra field length and the "BC" subfield holding the block size */
+static constexpr size_t g_BgzfHeaderSize{ 18U };
+static constexpr size_t g_GzipFooterSize{ 8U };
+static constexpr size_t g_StreamChunkSize{ 1U << 20U };
+
+template<typename T>
+static inline T ReadLittleEndian(const char* const bytes) noexcept
+{
+	T value{ 0U };
+	for (size_t i{ 0U }; i < sizeof(T); ++i)
+		value = static_cast<T>(value | (static_cast<T>(static_cast<uint8_t>(bytes[i])) << (i * 8U)));
+
+	return value;
+}
+
+/* Total size of the BGZF block starting the data, std::nullopt for any other gzip member */
+static std::optional<uint32_t> BgzfBlockSize(const std::string_view data) noexcept
+{
+	if (data.size() < g_BgzfHeaderSize || !GzipFile::IsCompressed(data) || data[2U] != 8 || (data[3U] & 0b100) == 0)
+		return std::nullopt;
+
+	const size_t extraLength{ ReadLittleEndian<uint16_t>(data.data() + 10U) };
+	if (data.size() < 12U + extraLength)
+		return std::nullopt;
+
+	const std::string_view extra{ data.substr(12U, extraLength) };
+	size_t position{ 0U };
+	while (position + 4U <= extra.size())
+	{
+		const uint16_t subfieldLength{ ReadLittleEndian<uint16_t>(extra.data() + position + 2U) };
+		if (extra[position] == 'B' && extra[position + 1U] == 'C' && subfieldLength == 2U && position + 6U <= extra.size())
+			return static_cast<uint32_t>(ReadLittleEndian<uint16_t>(extra.data() + position + 4U)) + 1U;
+
+		position += 4U + subfieldLength;
+	}
+
+	return std::nullopt;
+}
+
+GzipFile::GzipFile(const std::string_view compressed)
+	:
+	m_Compressed(compressed),
+	m_Blocks(IndexBlocks(compressed))
+{
+	BIO_UNLIKELY
+	if (!IsCompressed(compressed))
+		THROW_EXCEPTION("Invalid format - not a gzip file");
+}
+
+bool GzipFile::IsCompressed(const std::string_view data) noexcept
+{
+	return data.size() >= 2U && static_cast<uint8_t>(data[0U]) == 0x1FU && static_cast<uint8_t>(data[1U]) == 0x8BU;
+}
+
+std::string_view GzipFile::Read(const uint64_t begin, const uint64_t end, std::string& buffer) const
+{
+	if (!IsBlocked())
+	{
+		BIO_UNLIKELY
+		if (begin > end)
+			THROW_EXCEPTION("Read past the end of the file");
+
+		/* There is no way into the middle of a plain gzip file, everything in front of the range is inflated and dropped */
+		buffer.clear();
+		buffer.reserve(end - begin);
+
+		Stream stream{ *this };
+		std::string chunk;
+		uint64_t chunkBegin{ 0U };
+		while (chunkBegin < end)
+		{
+			chunk.clear();
+
+			BIO_UNLIKELY
+			if (stream.Read(chunk, g_StreamChunkSize) == 0U)
+				THROW_EXCEPTION("Read past the end of the file");
+
+			const uint64_t chunkEnd{ chunkBegin + chunk.size() };
+			if (chunkEnd > begin)
+			{
+				const uint64_t first{ std::max(begin, chunkBegin) };
+				buffer.append(chunk, first - chunkBegin, std::min(end, chunkEnd) - first);
+			}
+
+			chunkBegin = chunkEnd;
+		}
+
+		return buffer;
+	}
+
+	BIO_UNLIKELY
+	if (begin > end || end > GetSize())
+		THROW_EXCEPTION("Read past the end of the file");
+
+	if (begin == end)
+		return {};
+
+	const auto byUncompressedOffset{ [](const uint64_t offset, const BgzfBlock& block) { return offset < block.UncompressedOffset; } };
+	const auto first{ std::prev(std::upper_bound(m_Blocks.begin(), m_Blocks.end(), begin, byUncompressedOffset)) };
+	const auto last{ std::upper_bound(first, m_Blocks.end(), end - 1U, byUncompressedOffset) };
+
+	const uint64_t spanBegin{ first->UncompressedOffset };
+	const uint64_t spanEnd{ std::prev(last)->UncompressedOffset + std::prev(last)->UncompressedSize };
+
+	buffer.resize(spanEnd - spanBegin);
+	InflateBlocks(first, last, buffer.data());
+
+	/* The range is moved to the front, callers may keep working on the buffer in place */
+	buffer.erase(0U, begin - spanBegin);
+	buffer.resize(end - begin);
+	return buffer;
+}
+
+uint64_t GzipFile::GetSize() const noexcept
+{
+	if (IsBlocked())
+		return m_Blocks.back().UncompressedOffset + m_Blocks.back().UncompressedSize;
+
+	return m_Compressed.size() >= g_GzipFooterSize ? ReadLittleEndian<uint32_t>(m_Compressed.data() + m_Compressed.size() - 4U) : 0U;
+}
+
+std::vector<BgzfBlock> GzipFile::IndexBlocks(const std::string_view data)
+{
+	std::vector<BgzfBlock> blocks;
+	uint64_t compressedOffset{ 0U }, uncompressedOffset{ 0U };
+
+	/* Only the headers are touched, every block is skipped over using its stored size */
+	while (compressedOffset < data.size())
+	{
+		const std::optional<uint32_t> blockSize{ BgzfBlockSize(data.substr(compressedOffset)) };
+		if (!blockSize.has_value())
+		{
+			BIO_UNLIKELY
+			if (!blocks.empty())
+				THROW_EXCEPTION("Invalid format - corrupted BGZF block");
+
+			return blocks;
+		}
+
+		BIO_UNLIKELY
+		if (blockSize.value() < g_BgzfHeaderSize + g_GzipFooterSize || compressedOffset + blockSize.value() > data.size())
+			THROW_EXCEPTION("Invalid format - corrupted BGZF block");
+
+		const uint32_t uncompressedSize{ ReadLittleEndian<uint32_t>(data.data() + compressedOffset + blockSize.value() - 4U) };
+		blocks.push_back
+		({
+			.CompressedOffset{ compressedOffset },
+			.UncompressedOffset{ uncompressedOffset },
+			.CompressedSize{ blockSize.value() },
+			.UncompressedSize{ uncompressedSize }
+		});
+
+		compressedOffset += blockSize.value();
+		uncompressedOffset += uncompressedSize;
+	}
+
+	return blocks;
+}
+
+void GzipFile::InflateBlocks(const std::vector<BgzfBlock>::const_iterator first, const std::vector<BgzfBlock>::const_iterator last, char* const output) const
+{
+	const uint64_t outputOffset{ first->UncompressedOffset };
+	std::atomic<bool> corrupted{ false };
+
+	/* Blocks share no state, each one is inflated straight into its final place */
+	std::for_each(std::execution::par, first, last, [&](const BgzfBlock& block)
+	{
+		/* End of file marker */
+		if (block.UncompressedSize == 0U)
+			return;
+
+		FT_ULong inflatedSize{ block.UncompressedSize };
+		const FT_Error error
+		{
+			FT_Gzip_Uncompress
+			(
+				&g_InflateMemory,
+				reinterpret_cast<FT_Byte*>(output + (block.UncompressedOffset - outputOffset)),
+				&inflatedSize,
+				reinterpret_cast<const FT_Byte*>(m_Compressed.data() + block.CompressedOffset),
+				block.CompressedSize
+			)
+		};
+
+		BIO_UNLIKELY
+		if (error != 0 || inflatedSize != block.UncompressedSize)
+			corrupted = true;
+	});
+
+	BIO_UNLIKELY
+	if (corrupted)
+		THROW_EXCEPTION("Invalid format - corrupted BGZF block");
+}
+
+GzipFile::Stream::Stream(const GzipFile& file)
+	:
+	m_File(file),
+	m_NextBlock(0U),
+	m_Source(nullptr),
+	m_Inflater(nullptr),
+	m_SourcePosition(0U),
+	m_InflatedSize(0U),
+	m_AtEnd(false)
+{
+	if (m_File.IsBlocked())
+		return;
+
+	/* Sizes past 4 GiB don't fit FreeType on Windows, the source never checks it and the inflater only compares wrapped positions */
+	m_Source = std::make_unique<FT_StreamRec>();
+	m_Source->size = static_cast<unsigned long>(std::min<uint64_t>(m_File.m_Compressed.size(), std::numeric_limits<unsigned long>::max()));
+	m_Source->read = &ReadSource;
+	m_Source->descriptor.pointer = this;
+	m_Source->memory = &g_InflateMemory;
+
+	m_Inflater = std::make_unique<FT_StreamRec>();
+
+	BIO_UNLIKELY
+	if (FT_Stream_OpenGzip(m_Inflater.get(), m_Source.get()) != 0)
+	{
+		m_Inflater.reset();
+		THROW_EXCEPTION("Invalid format - corrupted gzip header");
+	}
+}
+
+GzipFile::Stream::~Stream() noexcept
+{
+	if (m_Inflater)
+		m_Inflater->close(m_Inflater.get());
+}
+
+size_t GzipFile::Stream::Read(std::string& output, const size_t size)
+{
+	if (m_AtEnd)
+		return 0U;
+
+	const size_t outputBegin{ output.size() };
+	if (m_File.IsBlocked())
+	{
+		/* Whole blocks up to the requested size, inflated in parallel straight into the output */
+		const auto first{ m_File.m_Blocks.begin() + static_cast<std::ptrdiff_t>(m_NextBlock) };
+		auto last{ first };
+		size_t readSize{ 0U };
+		while (last != m_File.m_Blocks.end() && (last == first || readSize + last->UncompressedSize <= size))
+			readSize += (last++)->UncompressedSize;
+
+		output.resize(outputBegin + readSize);
+		if (first != last)
+			m_File.InflateBlocks(first, last, output.data() + outputBegin);
+
+		m_NextBlock = static_cast<size_t>(last - m_File.m_Blocks.begin());
+		m_AtEnd = last == m_File.m_Blocks.end();
+		return readSize;
+	}
+
+	output.resize(outputBegin + size);
+
+	/* Small files are inflated whole while the stream is opened */
+	size_t readCount{ 0U };
+	if (!m_Inflater->read)
+	{
+		readCount = static_cast<size_t>(std::min<uint64_t>(size, m_Inflater->size - m_InflatedSize));
+		std::copy_n(m_Inflater->base + m_InflatedSize, readCount, output.data() + outputBegin);
+	}
+	else
+	{
+		/* Positions wrap the same way as the inflater's own, which they are only compared to */
+		readCount = m_Inflater->read(m_Inflater.get(), static_cast<unsigned long>(m_InflatedSize), reinterpret_cast<unsigned char*>(output.data() + outputBegin), static_cast<unsigned long>(size));
+	}
+
+	output.resize(outputBegin + readCount);
+	m_InflatedSize += readCount;
+	m_AtEnd = readCount < size;
+
+	/* Truncated data and concatenated members (only the first one is read) both show up as a size mismatch */
+	BIO_UNLIKELY
+	if (m_AtEnd && static_cast<uint32_t>(m_InflatedSize) != ReadLittleEndian<uint32_t>(m_File.m_Compressed.data() + m_File.m_Compressed.size() - 4U))
+		THROW_EXCEPTION("Invalid format - corrupted or multi-member gzip file");
+
+	return readCount;
+}
+
+unsigned long GzipFile::Stream::ReadSource(FT_StreamRec_* const source, const unsigned long position, unsigned char* const buffer, const unsigned long count)
+{
+	Stream& stream{ *static_cast<Stream*>(source->descriptor.pointer) };
+	const std::string_view compressed{ stream.m_File.m_Compressed };
+
+	/* Reads go on from the cursor, apart from the header at the start and the size stored in the trailer */
+	uint64_t widePosition{ position };
+	if (position == static_cast<unsigned long>(stream.m_SourcePosition))
+		widePosition = stream.m_SourcePosition;
+	else if (position == source->size - 4U)
+		widePosition = compressed.size() - 4U;
+
+	/* Seeks come without a buffer, anything but 0 fails them */
+	if (count == 0U)
+	{
+		if (widePosition > compressed.size())
+			return 1U;
+
+		stream.m_SourcePosition = widePosition;
+		return 0U;
+	}
+
+	if (widePosition >= compressed.size())
+		return 0U;
+
+	const size_t readCount{ static_cast<size_t>(std::min<uint64_t>(count, compressed.size() - widePosition)) };
+	std::copy_n(compressed.data() + widePosition, readCount, buffer);
+
+	stream.m_SourcePosition = widePosition + readCount;
+	return static_cast<unsigned long>(readCount);
+}
\ No newline at end of file
@@ -0,0 +1,193 @@
+#include "Lz4.hpp"
+
+static constexpr size_t g_MinimumMatch{ 4U };
+static constexpr size_t g_MaximumOffset{ 65535U };
+
+/* Format limits: a block ends with at least five literals and the last match starts twelve bytes before its end */
+static constexpr size_t g_LastLiterals{ 5U };
+static constexpr size_t g_MatchFindLimit{ 12U };
+
+static constexpr uint32_t g_HashLog{ 16U };
+static constexpr uint32_t g_NoPosition{ std::numeric_limits<uint32_t>::max() };
+
+/* Misses grow the search step, incompressible data is skipped over quickly */
+static constexpr uint32_t g_SkipTrigger{ 6U };
+
+static inline uint32_t ReadWord(const char* const bytes) noexcept
+{
+	uint32_t value;
+	std::memcpy(&value, bytes, sizeof(value));
+	return value;
+}
+
+static inline uint32_t HashWord(const uint32_t word) noexcept
+{
+	return (word * 2654435761U) >> (32U - g_HashLog);
+}
+
+static void AppendLength(std::string& output, size_t length)
+{
+	for (; length >= 255U; length -= 255U)
+		output += static_cast<char>(255U);
+
+	output += static_cast<char>(length);
+}
+
+static void AppendSequence(std::string& output, const std::string_view literals, const size_t offset, const size_t matchLength)
+{
+	const size_t literalToken{ std::min<size_t>(literals.size(), 15U) };
+	const size_t matchToken{ std::min<size_t>(matchLength - g_MinimumMatch, 15U) };
+	output += static_cast<char>(literalToken << 4U | matchToken);
+
+	if (literalToken == 15U)
+		AppendLength(output, literals.size() - 15U);
+
+	output += literals;
+
+	output += static_cast<char>(offset & 0xFFU);
+	output += static_cast<char>(offset >> 8U);
+
+	if (matchToken == 15U)
+		AppendLength(output, matchLength - g_MinimumMatch - 15U);
+}
+
+static void AppendLastLiterals(std::string& output, const std::string_view literals)
+{
+	const size_t literalToken{ std::min<size_t>(literals.size(), 15U) };
+	output += static_cast<char>(literalToken << 4U);
+
+	if (literalToken == 15U)
+		AppendLength(output, literals.size() - 15U);
+
+	output += literals;
+}
+
+void Lz4::Compress(const std::string_view input, std::string& output)
+{
+	output.reserve(output.size() + CompressBound(input.size()));
+
+	BIO_UNLIKELY
+	if (input.size() > std::numeric_limits<uint32_t>::max() - 1U)
+		THROW_EXCEPTION("Block too large to compress");
+
+	size_t anchor{ 0U };
+
+	BIO_LIKELY
+	if (input.size() > g_MatchFindLimit)
+	{
+		/* Positions of the last occurrence of each hashed word */
+		std::vector<uint32_t> hashTable(size_t{ 1U } << g_HashLog, g_NoPosition);
+
+		const size_t matchFindEnd{ input.size() - g_MatchFindLimit };
+		const size_t matchEnd{ input.size() - g_LastLiterals };
+
+		size_t position{ 0U };
+		uint32_t misses{ 0U };
+		while (position <= matchFindEnd)
+		{
+			const uint32_t word{ ReadWord(input.data() + position) };
+			uint32_t& candidate{ hashTable[HashWord(word)] };
+			const uint32_t reference{ candidate };
+			candidate = static_cast<uint32_t>(position);
+
+			if (reference == g_NoPosition || position - reference > g_MaximumOffset || ReadWord(input.data() + reference) != word)
+			{
+				position += 1U + (misses++ >> g_SkipTrigger);
+				continue;
+			}
+
+			size_t matchLength{ g_MinimumMatch };
+			while (position + matchLength < matchEnd && input[reference + matchLength] == input[position + matchLength])
+				++matchLength;
+
+			AppendSequence(output, input.substr(anchor, position - anchor), position - reference, matchLength);
+
+			position += matchLength;
+			anchor = position;
+			misses = 0U;
+		}
+	}
+
+	AppendLastLiterals(output, input.substr(anchor));
+}
+
+void Lz4::Decompress(const std::string_view input, char* const output, const size_t outputSize)
+{
+	size_t inputPosition{ 0U };
+	size_t outputPosition{ 0U };
+
+	const auto readLength
+	{
+		[&input, &inputPosition](size_t length)
+		{
+			uint8_t extension{ 255U };
+			while (extension == 255U)
+			{
+				BIO_UNLIKELY
+				if (inputPosition >= input.size())
+					THROW_EXCEPTION("Truncated LZ4 block");
+
+				extension = static_cast<uint8_t>(input[inputPosition++]);
+				length += extension;
+			}
+
+			return length;
+		}
+	};
+
+	while (true)
+	{
+		BIO_UNLIKELY
+		if (inputPosition >= input.size())
+			THROW_EXCEPTION("Truncated LZ4 block");
+
+		const uint8_t token{ static_cast<uint8_t>(input[inputPosition++]) };
+
+		size_t literalLength{ static_cast<size_t>(token >> 4U) };
+		if (literalLength == 15U)
+			literalLength = readLength(literalLength);
+
+		BIO_UNLIKELY
+		if (literalLength > input.size() - inputPosition || literalLength > outputSize - outputPosition)
+			THROW_EXCEPTION("Malformed LZ4 block");
+
+		std::memcpy(output + outputPosition, input.data() + inputPosition, literalLength);
+		inputPosition += literalLength;
+		outputPosition += literalLength;
+
+		/* The last sequence only carries literals */
+		if (inputPosition == input.size())
+			break;
+
+		BIO_UNLIKELY
+		if (input.size() - inputPosition < 2U)
+			THROW_EXCEPTION("Truncated LZ4 block");
+
+		const size_t offset{ static_cast<size_t>(static_cast<uint8_t>(input[inputPosition])) | static_cast<size_t>(static_cast<uint8_t>(input[inputPosition + 1U])) << 8U };
+		inputPosition += 2U;
+
+		size_t matchLength{ static_cast<size_t>(token & 0x0FU) };
+		if (matchLength == 15U)
+			matchLength = readLength(matchLength);
+
+		matchLength += g_MinimumMatch;
+
+		BIO_UNLIKELY
+		if (offset == 0U || offset > outputPosition || matchLength > outputSize - outputPosition)
+			THROW_EXCEPTION("Malformed LZ4 block");
+
+		/* Matches may overlap the bytes they produce (runs), those are copied forward one by one */
+		const char* source{ output + outputPosition - offset };
+		if (offset >= matchLength)
+			std::memcpy(output + outputPosition, source, matchLength);
+		else
+			for (size_t i{ 0U }; i < matchLength; ++i)
+				output[outputPosition + i] = source[i];
+
+		outputPosition += matchLength;
+	}
+
+	BIO_UNLIKELY
+	if (outputPosition != outputSize)
+		THROW_EXCEPTION("Malformed LZ4 block");
+}
\ No newline at end of file
@@ -4,6 +4,10 @@
 #include "Amino.hpp"
 #include "AminoX.hpp"
 #include "Transform.hpp"
+#include "OpenReadingFrames.hpp"
+#include "CodingPotential.hpp"
+#include "Lz4.hpp"
+#include <sstream>
 #include <Windows.h>
 #include <stdint.h>
 
@@ -58,7 +62,17 @@ static void TestCodonTranslation();
 
 static void TestPropertyCalculations();
 
-#define LOG(x) fprintf(stdout, "%s\n", x)
+static void TestOpenReadingFrames();
+
+static void TestCodingPotential();
+
+static void TestCodonUsage();
+
+static void TestCompression();
+
+static void TestNucleotidePacking();
+static void TestSequenceHash();
+
 INT APIENTRY wWinMain(
 	_In_ HINSTANCE hInstance,
 	_In_opt_ HINSTANCE hPrevInstance,
@@ -115,6 +129,23 @@ INT APIENTRY wWinMain(
 	LOG("Testing property calculations...");
 	TestPropertyCalculations();
 
+	LOG("Testing open reading frames...");
+	TestOpenReadingFrames();
+
+	LOG("Testing coding potential...");
+	TestCodingPotential();
+
+	LOG("Testing codon usage...");
+	TestCodonUsage();
+
+	LOG("Testing compression...");
+	TestCompression();
+
+	LOG("Testing nucleotide packing...");
+	TestNucleotidePacking();
+	LOG("Testing sequence hash...");
+	TestSequenceHash();
+
 	LOG("============================");
 	LOG("           SUMMARY			 ");
 	LOG("============================");
@@ -563,6 +594,22 @@ static void TestDNATranslation()
 	FORCE_ASSERT(fromVector[7].AsCharacter() == 'T');
 	FORCE_ASSERT(fromVector[8].AsCharacter() == 'G');
 
+	auto fromRecord{ Bio::EncodeDNA(std::string_view("atgA\r\nTGc\nN ug")) };
+	FORCE_ASSERT(fromRecord.size() == 9U);
+	FORCE_ASSERT(fromRecord[0].AsCharacter() == 'A');
+	FORCE_ASSERT(fromRecord[3].AsCharacter() == 'A');
+	FORCE_ASSERT(fromRecord[6].AsCharacter() == 'C');
+	FORCE_ASSERT(fromRecord[7].AsCharacter() == 'T');
+	FORCE_ASSERT(fromRecord[8].AsCharacter() == 'G');
+
+	auto reversed{ Bio::EncodeDNAReversed(std::string_view("aacg\nt")) };
+	FORCE_ASSERT(reversed.size() == 5U);
+	FORCE_ASSERT(reversed[0].AsCharacter() == 'A');
+	FORCE_ASSERT(reversed[1].AsCharacter() == 'C');
+	FORCE_ASSERT(reversed[2].AsCharacter() == 'G');
+	FORCE_ASSERT(reversed[3].AsCharacter() == 'T');
+	FORCE_ASSERT(reversed[4].AsCharacter() == 'T');
+
 	PASS_TEST();
 }
 
@@ -642,6 +689,13 @@ static void TestRNATranslation()
 	FORCE_ASSERT(fromVector[7].AsCharacter() == 'U');
 	FORCE_ASSERT(fromVector[8].AsCharacter() == 'G');
 
+	auto fromRecord{ Bio::EncodeRNA(std::string_view("aug\r\nAUG\n")) };
+	FORCE_ASSERT(fromRecord.size() == 6U);
+	FORCE_ASSERT(fromRecord[0].AsCharacter() == 'A');
+	FORCE_ASSERT(fromRecord[1].AsCharacter() == 'U');
+	FORCE_ASSERT(fromRecord[5].AsCharacter() == 'G');
+
+
 	PASS_TEST();
 }
 
@@ -1223,3 +1277,363 @@ void TestPropertyCalculations()
 
 	PASS_TEST();
 }
+
+void TestOpenReadingFrames()
+{
+	/* M  V  M  -  G  M  L  */
+	/* AUG GUG AUG UAA GGG AUG UUG */
+	const Bio::RnaSequence rna{ "AUGGUGAUGUAAGGGAUGUUG"_Rnas };
+
+	const auto scan
+	{
+		[&rna](const Bio::OpenReadingFrameFlags flags)
+		{
+			Bio::OpenReadingFrameScanner scanner;
+			const Bio::AminoSequence amino{ Bio::TranslateNucleotideSequence(rna, scanner) };
+			const auto& openReadingFrameStarts{ scanner.Finish() };
+			return std::make_pair(amino, Bio::GatherSelection(openReadingFrameStarts, Bio::SelectOpenReadingFrames(openReadingFrameStarts, flags)));
+		}
+	};
+
+	{
+		const auto [amino, openReadingFrames] { scan(Bio::OpenReadingFrameFlags_None) };
+		FORCE_ASSERT(Bio::ConvertToString(amino) == "MVM-GML");
+		FORCE_ASSERT(openReadingFrames.size() == 2U);
+
+		const auto candidates{ Bio::ExtractProteinCandidates(amino, openReadingFrames) };
+		FORCE_ASSERT(Bio::ConvertToString(candidates[0]) == "MVM");
+		FORCE_ASSERT(Bio::ConvertToString(candidates[1]) == "ML");
+	}
+
+	{
+		const auto [amino, openReadingFrames] { scan(Bio::OpenReadingFrameFlags_Nested) };
+		FORCE_ASSERT(openReadingFrames.size() == 3U);
+
+		const auto candidates{ Bio::ExtractProteinCandidates(amino, openReadingFrames) };
+		FORCE_ASSERT(Bio::ConvertToString(candidates[0]) == "MVM");
+		FORCE_ASSERT(Bio::ConvertToString(candidates[1]) == "M");
+		FORCE_ASSERT(Bio::ConvertToString(candidates[2]) == "ML");
+	}
+
+	{
+		const auto [amino, openReadingFrames] { scan(Bio::OpenReadingFrameFlags_Nested | Bio::OpenReadingFrameFlags_AlternativeStarts) };
+		FORCE_ASSERT(openReadingFrames.size() == 5U);
+
+		const auto candidates{ Bio::ExtractProteinCandidates(amino, openReadingFrames) };
+		FORCE_ASSERT(Bio::ConvertToString(candidates[1]) == "MM");
+		FORCE_ASSERT(Bio::ConvertToString(candidates[4]) == "M");
+		FORCE_ASSERT(openReadingFrames[4].AlternativeStart);
+		FORCE_ASSERT(openReadingFrames[4].Begin == 6U && openReadingFrames[4].End == 7U);
+	}
+
+	{
+		const auto openReadingFrameStarts{ Bio::ScanOpenReadingFrameStarts("AMKM-MG"_Aminos) };
+		FORCE_ASSERT(openReadingFrameStarts.size() == 3U);
+		FORCE_ASSERT(Bio::SelectOpenReadingFrames(openReadingFrameStarts, Bio::OpenReadingFrameFlags_Nested).size() == 3U);
+
+		const auto openReadingFrames{ Bio::GatherSelection(openReadingFrameStarts, Bio::SelectOpenReadingFrames(openReadingFrameStarts, Bio::OpenReadingFrameFlags_None)) };
+		FORCE_ASSERT(openReadingFrames.size() == 2U);
+		FORCE_ASSERT(openReadingFrames[0].Begin == 1U && openReadingFrames[0].End == 4U);
+		FORCE_ASSERT(openReadingFrames[1].Begin == 5U && openReadingFrames[1].End == 7U);
+	}
+
+	{
+		/* Every mode is selected from the same starts, the outermost start depends on whether alternative ones are taken */
+		/* GUG AUG UAA */
+		Bio::OpenReadingFrameScanner scanner;
+		Bio::TranslateNucleotideSequence("GUGAUGUAA"_Rnas, scanner);
+		const auto& openReadingFrameStarts{ scanner.Finish() };
+		FORCE_ASSERT(openReadingFrameStarts.size() == 2U);
+
+		const auto outermost{ Bio::SelectOpenReadingFrames(openReadingFrameStarts, Bio::OpenReadingFrameFlags_None) };
+		FORCE_ASSERT(outermost.size() == 1U && openReadingFrameStarts[outermost[0]].Begin == 1U);
+
+		const auto alternative{ Bio::SelectOpenReadingFrames(openReadingFrameStarts, Bio::OpenReadingFrameFlags_AlternativeStarts) };
+		FORCE_ASSERT(alternative.size() == 1U && openReadingFrameStarts[alternative[0]].Begin == 0U && openReadingFrameStarts[alternative[0]].AlternativeStart);
+
+		FORCE_ASSERT(Bio::SelectOpenReadingFrames(openReadingFrameStarts, Bio::OpenReadingFrameFlags_Nested | Bio::OpenReadingFrameFlags_AlternativeStarts).size() == 2U);
+	}
+
+	{
+		/* Alternative starts are stored as M in the candidates */
+		const auto [amino, openReadingFrames] { scan(Bio::OpenReadingFrameFlags_Nested | Bio::OpenReadingFrameFlags_AlternativeStarts) };
+		const auto located{ Bio::LocateOpenReadingFrames(amino, Bio::ExtractProteinCandidates(amino, openReadingFrames)) };
+
+		FORCE_ASSERT(located.size() == openReadingFrames.size());
+		for (size_t i{ 0U }; i < located.size(); ++i)
+		{
+			FORCE_ASSERT(located[i].Begin == openReadingFrames[i].Begin);
+			FORCE_ASSERT(located[i].End == openReadingFrames[i].End);
+			FORCE_ASSERT(located[i].AlternativeStart == openReadingFrames[i].AlternativeStart);
+		}
+	}
+
+	{
+		/* Candidates from text projects that aren't in the translation come back as empty ranges, project files never store those */
+		const auto located{ Bio::LocateOpenReadingFrames("MKA-MG"_Aminos, { "MKA"_Aminos, "MWW"_Aminos }) };
+		FORCE_ASSERT(located.size() == 2U);
+		FORCE_ASSERT(located[0].Begin == 0U && located[0].End == 3U);
+		FORCE_ASSERT(located[1].Begin == 0U && located[1].End == 0U);
+	}
+
+	{
+		/* A leading M matches an M first, residues before it that merely end at a stop aren't starts */
+		const auto located{ Bio::LocateOpenReadingFrames("AL-ML-"_Aminos, { "ML"_Aminos }) };
+		FORCE_ASSERT(located[0].Begin == 3U && located[0].End == 5U && !located[0].AlternativeStart);
+
+		const auto single{ Bio::LocateOpenReadingFrames("AK-M-"_Aminos, { "M"_Aminos }) };
+		FORCE_ASSERT(single[0].Begin == 3U && single[0].End == 4U && !single[0].AlternativeStart);
+	}
+
+	{
+		/* Without an M only V (GUG) and L (UUG) can stand for it */
+		const auto alternative{ Bio::LocateOpenReadingFrames("AL-"_Aminos, { "M"_Aminos }) };
+		FORCE_ASSERT(alternative[0].Begin == 1U && alternative[0].End == 2U && alternative[0].AlternativeStart);
+
+		const auto unlocated{ Bio::LocateOpenReadingFrames("AK-"_Aminos, { "M"_Aminos }) };
+		FORCE_ASSERT(unlocated[0].Begin == 0U && unlocated[0].End == 0U);
+	}
+
+	PASS_TEST();
+}
+
+void TestCodingPotential()
+{
+	/* AUG GCU GCU GCU AAA GGC UAA */
+	const Bio::RnaSequence rna{ "AUGGCUGCUGCUAAAGGCUAA"_Rnas };
+	const std::vector<Bio::OpenReadingFrame> openReadingFrames{ { .Begin{ 0U }, .End{ 6U }, .AlternativeStart{ false } } };
+
+	{
+		const auto codingPotentials{ Bio::CalculateCodingPotentials(rna, openReadingFrames) };
+		FORCE_ASSERT(codingPotentials.size() == 1U);
+		FORCE_ASSERT(Approximate<0.0001>(codingPotentials[0].Fickett, 1.064));
+		FORCE_ASSERT(!codingPotentials[0].Hexamer.has_value());
+	}
+
+	{
+		std::istringstream input
+		{
+			"hexamer\tcoding\tnoncoding\n"
+			"ATGGCT\t0.02\t0.01\n"
+			"GCUGCU\t0.01\t0\n"
+			"GCTAAA\t0\t0.01\n"
+			"AAAGGC\t0\t0\n"
+		};
+
+		Bio::HexamerTable hexamerTable;
+		FORCE_ASSERT(hexamerTable.Load(input));
+
+		/* (ln(2) + 1 + 1 - 1) / 4, AAAGGC has no data and is skipped */
+		const auto codingPotentials{ Bio::CalculateCodingPotentials(rna, openReadingFrames, &hexamerTable) };
+		FORCE_ASSERT(codingPotentials[0].Hexamer.has_value());
+		FORCE_ASSERT(Approximate<0.0001>(codingPotentials[0].Hexamer.value(), (std::log(2.0) + 1.0) / 4.0));
+	}
+
+	PASS_TEST();
+}
+
+void TestCodonUsage()
+{
+	/* AUG GUG AUG UAA GGG AUG UUG */
+	const Bio::RnaSequence rna{ "AUGGUGAUGUAAGGGAUGUUG"_Rnas };
+	const auto codon{ [](const std::string_view triplet) { return Bio::CodonIndex(Bio::Rna{}.AssignCharacter(triplet[0]), Bio::Rna{}.AssignCharacter(triplet[1]), Bio::Rna{}.AssignCharacter(triplet[2])); } };
+
+	Bio::OpenReadingFrameScanner scanner;
+	Bio::TranslateNucleotideSequence(rna, scanner);
+	const auto& openReadingFrameStarts{ scanner.Finish() };
+	const auto& startCodonUsages{ scanner.GetCodonUsages() };
+	FORCE_ASSERT(startCodonUsages.size() == openReadingFrameStarts.size());
+
+	/* Outermost frames */
+	const auto codonUsages{ Bio::GatherSelection(startCodonUsages, Bio::SelectOpenReadingFrames(openReadingFrameStarts, Bio::OpenReadingFrameFlags_None)) };
+	FORCE_ASSERT(codonUsages.size() == 2U);
+	FORCE_ASSERT(codonUsages[0].Total() == 3U && codonUsages[0][codon("AUG")] == 2U && codonUsages[0][codon("GUG")] == 1U);
+	FORCE_ASSERT(codonUsages[1].Total() == 2U && codonUsages[1][codon("UUG")] == 1U);
+	FORCE_ASSERT(codonUsages[0][codon("UAA")] == 0U);
+
+	const Bio::CodonUsage& sequenceCodonUsage{ scanner.GetSequenceCodonUsage() };
+	FORCE_ASSERT(sequenceCodonUsage.Total() == 7U && sequenceCodonUsage[codon("UAA")] == 1U);
+
+	const auto counted{ Bio::CountCodonUsages(rna, openReadingFrameStarts) };
+	for (size_t i{ 0U }; i < openReadingFrameStarts.size(); ++i)
+	{
+		const Bio::CodonUsage recounted{ Bio::CountCodonUsage(rna, openReadingFrameStarts[i].Begin, openReadingFrameStarts[i].End) };
+		FORCE_ASSERT(recounted.Counts == startCodonUsages[i].Counts);
+		FORCE_ASSERT(counted[i].Counts == startCodonUsages[i].Counts);
+	}
+
+	FORCE_ASSERT((codonUsages[0] + codonUsages[1])[codon("AUG")] == 3U);
+
+	{
+		Bio::CodonUsage reference;
+		reference[codon("UUG")] = 10U;
+		reference[codon("CUG")] = 20U;
+		reference[codon("GUG")] = 5U;
+		reference[codon("GUU")] = 5U;
+
+		/* Met is skipped, GUG = 1, UUG = 0.5 */
+		const Bio::CodonAdaptationTable codonAdaptationTable{ reference };
+		const auto codonAdaptationIndex{ codonAdaptationTable.Calculate(codonUsages[0] + codonUsages[1]) };
+		FORCE_ASSERT(codonAdaptationIndex.has_value() && Approximate<0.0001>(codonAdaptationIndex.value(), std::sqrt(0.5)));
+	}
+
+	{
+		std::istringstream input{ "codon count\nTTG 10\nCTG 20\n" };
+		Bio::CodonAdaptationTable codonAdaptationTable;
+		FORCE_ASSERT(codonAdaptationTable.Load(input));
+
+		const auto codonAdaptationIndex{ codonAdaptationTable.Calculate(codonUsages[1]) };
+		FORCE_ASSERT(codonAdaptationIndex.has_value() && Approximate<0.0001>(codonAdaptationIndex.value(), 0.5));
+	}
+
+	PASS_TEST();
+}
+
+void TestCompression()
+{
+	const auto roundTrip
+	{
+		[](const std::string_view input)
+		{
+			std::string compressed;
+			Lz4::Compress(input, compressed);
+
+			std::string output(input.size(), '\0');
+			Lz4::Decompress(compressed, output.data(), output.size());
+			FORCE_ASSERT(output == input);
+			FORCE_ASSERT(compressed.size() <= Lz4::CompressBound(input.size()));
+			FORCE_ASSERT(input.size() <= Lz4::DecompressBound(compressed.size()));
+			return compressed;
+		}
+	};
+
+	/* Deterministic bytes that don't repeat */
+	std::string incompressible(100000U, '\0');
+	uint32_t state{ 12345U };
+	for (char& byte : incompressible)
+	{
+		state = state * 1664525U + 1013904223U;
+		byte = static_cast<char>(state >> 24U);
+	}
+
+	std::string periodic;
+	for (size_t i{ 0U }; i < 100000U; ++i)
+		periodic += "ACGTTGCA"[i % 7U];
+
+	{
+		const std::string compressed{ roundTrip("") };
+		FORCE_ASSERT(!compressed.empty());
+		roundTrip("ACG");
+		roundTrip("ACGTACGTACGTA");
+	}
+
+	{
+		const std::string compressed{ roundTrip(incompressible) };
+		FORCE_ASSERT(compressed.size() > incompressible.size());
+	}
+
+	{
+		const std::string runs{ std::string(50000U, 'A') + std::string(50000U, 'C') };
+		FORCE_ASSERT(roundTrip(runs).size() < runs.size() / 100U);
+		FORCE_ASSERT(roundTrip(periodic).size() < periodic.size() / 100U);
+	}
+
+	{
+		/* Project sections are compressed in 256 KB blocks, every block on its own */
+		constexpr size_t blockSize{ 256U * 1024U };
+
+		std::string sections;
+		while (sections.size() < 3U * blockSize)
+			sections += periodic + incompressible;
+
+		for (size_t blockBegin{ 0U }; blockBegin < sections.size(); blockBegin += blockSize)
+			roundTrip(std::string_view{ sections }.substr(blockBegin, blockSize));
+
+		roundTrip(sections);
+	}
+
+	{
+		std::string compressed;
+		Lz4::Compress(periodic, compressed);
+
+		/* Sizes other than the stored one and cut blocks are rejected */
+		const auto isRejected
+		{
+			[](const std::string_view input, const size_t outputSize)
+			{
+				std::string output(outputSize, '\0');
+				try
+				{
+					Lz4::Decompress(input, output.data(), output.size());
+				}
+				catch (...)
+				{
+					return true;
+				}
+
+				return false;
+			}
+		};
+
+		FORCE_ASSERT(isRejected(compressed, periodic.size() - 1U));
+		FORCE_ASSERT(isRejected(compressed, periodic.size() + 1U));
+		FORCE_ASSERT(isRejected(std::string_view{ compressed }.substr(0U, compressed.size() / 2U), periodic.size()));
+	}
+
+	PASS_TEST();
+}
+
+void TestNucleotidePacking()
+{
+	{
+		/* A, U, G in the lowest bits first */
+		const Bio::RnaSequence rna{ Bio::EncodeRNA(std::string_view("aug\r\nAUG\n")) };
+		const auto packed{ Bio::PackNucleotides(rna) };
+		FORCE_ASSERT(packed.size() == 2U);
+		FORCE_ASSERT(packed[0] == static_cast<uint8_t>(rna[0].AsState() | rna[1].AsState() << 2U | rna[2].AsState() << 4U | rna[3].AsState() << 6U));
+		FORCE_ASSERT(packed[1] == static_cast<uint8_t>(rna[4].AsState() | rna[5].AsState() << 2U));
+
+		const auto unpacked{ Bio::UnpackNucleotides<Bio::Rna>(packed.data(), rna.size()) };
+		FORCE_ASSERT(unpacked.size() == rna.size());
+		for (size_t i{ 0U }; i < unpacked.size(); ++i)
+			FORCE_ASSERT(unpacked[i].AsCharacter() == rna[i].AsCharacter());
+	}
+
+	/* Every length around the byte boundaries, the last byte is only partly used */
+	const std::string_view text{ "ACGTTGCAAC" };
+	for (size_t size{ 0U }; size <= text.size(); ++size)
+	{
+		const Bio::DnaSequence dna{ Bio::ConvertToDNA(text.substr(0U, size)) };
+		const auto packed{ Bio::PackNucleotides(dna) };
+		FORCE_ASSERT(packed.size() == (size + 3U) / 4U);
+
+		const auto unpacked{ Bio::UnpackNucleotides<Bio::Dna>(packed.data(), size) };
+		FORCE_ASSERT(unpacked.size() == size);
+		for (size_t i{ 0U }; i < size; ++i)
+			FORCE_ASSERT(unpacked[i].AsCharacter() == text[i]);
+	}
+
+	PASS_TEST();
+}
+
+void TestSequenceHash()
+{
+	/* The states are hashed, not the characters they were read from */
+	const Bio::RnaSequence rna{ Bio::EncodeRNA(std::string_view("aug\r\nAUG\n")) };
+	FORCE_ASSERT(Bio::HashSequence(rna) == Bio::HashSequence(Bio::EncodeRNA("AUGAUG")));
+	FORCE_ASSERT(Bio::HashSequence(rna) != Bio::HashSequence(Bio::EncodeRNA("AUGAUC")));
+	FORCE_ASSERT(Bio::HashSequence(rna) != Bio::HashSequence(Bio::EncodeRNA("AUGAUGA")));
+
+	/* One byte per state, the same bytes hash the same whatever holds them */
+	std::string states;
+	for (const Bio::Rna nucleotide : rna)
+		states += static_cast<char>(nucleotide.AsState());
+
+	FORCE_ASSERT(Bio::HashSequence(rna) == Bio::HashSequence(std::string_view{ states }));
+
+	/* Amino sequences are hashed as text */
+	FORCE_ASSERT(Bio::HashSequence(std::string("MIK")) == Bio::HashSequence(std::string_view("MIKL").substr(0U, 3U)));
+	FORCE_ASSERT(Bio::HashSequence(std::string_view("MIK")) != Bio::HashSequence(std::string_view("MIKL")));
+
+	PASS_TEST();
+}
\ No newline at end of file
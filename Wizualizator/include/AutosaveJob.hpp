@@ -0,0 +1,36 @@
+#pragma once
+#include "Core.hpp"
+#include "Project.hpp"
+
+/*
+* Periodic save of the project on its own thread
+* The main thread only takes a snapshot of the registry, the worker writes it next to the autosave and renames it over it
+*/
+class AutosaveJob
+{
+private:
+	NON_COPYABLE(AutosaveJob)
+public:
+	AutosaveJob(ProjectSnapshot&& snapshot, std::filesystem::path&& path);
+	~AutosaveJob() noexcept;
+
+	/* Main thread, every frame: starts a save once the interval passed and the project changed since the last one */
+	static void Update(const std::filesystem::path& projectPath);
+
+	/* Blocks until the save in flight is written, the project file itself shouldn't be touched before */
+	static void Wait() noexcept;
+
+	/* Drops the autosave of a project whose changes were saved (or thrown away) */
+	static void Discard(const std::filesystem::path& projectPath) noexcept;
+
+	/* Next to the project, untitled projects are autosaved to the temporary directory */
+	[[nodiscard]] static std::filesystem::path GetPath(const std::filesystem::path& projectPath);
+private:
+	std::atomic<bool> m_Finished{ false };
+	std::thread m_Worker;
+
+	static constexpr std::chrono::seconds s_Interval{ 60 };
+	static inline std::unique_ptr<AutosaveJob> s_Job;
+	static inline std::chrono::steady_clock::time_point s_LastSaveTime{ std::chrono::steady_clock::now() };
+	static inline uint64_t s_SavedRevision{ 0U };
+};
\ No newline at end of file
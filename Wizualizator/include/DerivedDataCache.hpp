@@ -0,0 +1,58 @@
+#pragma once
+#include "Core.hpp"
+#include "LruCache.hpp"
+
+class MappedFile;
+
+/*
+* Results of the selection calculations kept between sessions in a sidecar next to the project (<name>.viscache)
+* Entries are keyed by the content hash of the amino sequence plus the parameters the result depends on
+* The sidecar is mapped and searched in place, results computed since it was opened are merged into it on save
+* Those are kept within a byte budget, the least recently used ones are dropped (and recomputed when needed again)
+*/
+class DerivedDataCache
+{
+private:
+	NON_COPYABLE(DerivedDataCache)
+public:
+	enum class EKind : uint32_t
+	{
+		IsoelectricPoint	= 0,
+		IsoelectricCurve	= 1,	/* Tested pH values followed by the results */
+		Hydropathy			= 2,	/* Indices followed by the max and min score, parameter is the window size */
+		NetCharge			= 3		/* Parameter holds the bits of the pH */
+	};
+
+	struct Key
+	{
+		uint64_t Hash;
+		EKind Kind;
+		uint32_t Parameter;
+
+		auto operator<=>(const Key&) const = default;
+	};
+
+	/* Drops the results of the previous project, a missing or outdated sidecar leaves the cache empty */
+	static void Open(const std::filesystem::path& projectPath) noexcept;
+
+	/*
+	* Rewrites the sidecar when anything was computed since it was opened or anything is dropped, a failure only loses the cache
+	* Entries of hashes missing from contentHashes (sorted) are dropped, without them everything is kept
+	*/
+	static void Save(const std::filesystem::path& projectPath, const std::optional<std::vector<uint64_t>>& contentHashes) noexcept;
+
+	static void Close() noexcept;
+
+	[[nodiscard]] static std::optional<std::vector<double>> Find(const Key& key);
+	static void Store(const Key& key, std::vector<double>&& values);
+
+	[[nodiscard]] static std::filesystem::path GetPath(const std::filesystem::path& projectPath);
+private:
+	[[nodiscard]] static std::optional<std::vector<double>> FindMapped(const Key& key);
+
+	static inline std::shared_ptr<const MappedFile> s_MappedFile;
+	static inline std::filesystem::path s_MappedPath;
+	static inline size_t s_MappedEntryCount{ 0U };
+	static constexpr size_t s_StoredEntriesBudget{ 64U * 1024U * 1024U };
+	static inline LruCache<Key, std::vector<double>> s_StoredEntries{ s_StoredEntriesBudget };
+};
\ No newline at end of file
@@ -1,17 +1,153 @@
 #pragma once
 #include "Core.hpp"
+#include "SequenceFile.hpp"
+
+struct FastaRecord
+{
+	std::string_view Name;
+	std::string_view Content;	/* Raw bytes inside the mapping (or the inflated file), line breaks included */
+
+	/* Residues as one contiguous run, line breaks are only stripped when there are any */
+	[[nodiscard]] std::string_view Contiguous(std::string& buffer) const;
+
+	/* Residues with the line breaks still in, for encoders skipping them as they go (nothing is copied) */
+	[[nodiscard]] std::string_view Residues() const;
+};
+
+/* samtools faidx compatible entry */
+struct FastaIndexEntry
+{
+	std::string Name;	/* Header up to the first whitespace */
+	uint64_t Length;	/* Residues in the record */
+	uint64_t Offset;	/* Byte offset of the first residue */
+	uint32_t LineBases;	/* Residues per full line */
+	uint32_t LineWidth;	/* Bytes per full line, line break included */
+
+	/* Byte offset of a residue, full lines are assumed to have the same width */
+	[[nodiscard]] inline uint64_t ResidueOffset(const uint64_t residue) const noexcept
+	{
+		return Offset + residue / LineBases * LineWidth + residue % LineBases;
+	}
+};
+
+class FastaIndex
+{
+public:
+	FastaIndex() = default;
+	~FastaIndex() noexcept = default;
+
+	/* Single pass over the file, throws on records with uneven line lengths */
+	[[nodiscard]] static FastaIndex Build(const SequenceFile& file);
+	[[nodiscard]] static std::optional<FastaIndex> Load(const std::filesystem::path& path);
+	void Save(const std::filesystem::path& path) const;
+
+	[[nodiscard]] const FastaIndexEntry* Find(const std::string_view name) const;
+
+	[[nodiscard]] inline const std::vector<FastaIndexEntry>& GetEntries() const noexcept
+	{
+		return m_Entries;
+	}
+private:
+	void Add(FastaIndexEntry&& entry);
+private:
+	std::vector<FastaIndexEntry> m_Entries;
+	std::unordered_map<std::string, size_t> m_EntryLookup;
+};
+
+/* Zero based, end exclusive */
+struct FastaRegion
+{
+	std::string_view Name;
+	uint64_t Begin;
+	uint64_t End;
+};
 
 class FastaReader
 {
 private:
+	NON_COPYABLE(FastaReader)
+public:
+	/* Parses one record of a text per increment, nothing but the current record is held */
+	class RecordIterator
+	{
+	public:
+		using iterator_category = std::input_iterator_tag;
+		using value_type		= FastaRecord;
+		using difference_type	= std::ptrdiff_t;
+		using pointer			= const FastaRecord*;
+		using reference			= const FastaRecord&;
+
+		RecordIterator() noexcept = default;
+		explicit RecordIterator(const std::string_view file);
+
+		inline reference operator*() const noexcept
+		{
+			return m_Record;
+		}
+
+		inline pointer operator->() const noexcept
+		{
+			return &m_Record;
+		}
+
+		inline RecordIterator& operator++()
+		{
+			Advance();
+			return *this;
+		}
+
+		inline void operator++(int)
+		{
+			Advance();
+		}
+
+		inline bool operator==(const RecordIterator& other) const noexcept
+		{
+			return m_AtEnd == other.m_AtEnd && (m_AtEnd || m_Lines.GetPosition() == other.m_Lines.GetPosition());
+		}
+	private:
+		void Advance();
+	private:
+		std::string_view m_File{};
+		LineReader m_Lines{};
+		FastaRecord m_Record{};
+		bool m_AtEnd{ true };
+	};
 public:
 	explicit FastaReader(const std::filesystem::path& path);
-	~FastaReader() noexcept;
+	~FastaReader() noexcept = default;
 
-	/* Sequence name -> sequence content */
-	[[nodiscard]] std::vector<std::pair<std::string, std::string>> ReadNucleotideSequences() const;
-private:
-	mutable std::ifstream m_File;
+	/* The extensions of the import dialog (".fasta", ".fa", ".fna", ".faa", ".frn", ".txt") and their ".gz" variants */
+	[[nodiscard]] static bool HasFastaExtension(const std::filesystem::path& path);
+
+	/*
+	* Records are handed over in batches of about s_BatchSize bytes of the file, each batch is parsed on all cores
+	* Batches come in the file order, their records point into the read window and are only valid during the call
+	* A stop request ends the reading before the next batch
+	*/
+	void ReadRecords(const std::function<void(std::span<const FastaRecord> records)>& consumer, const std::stop_token& stopToken = {}) const;
+
+	/* Uncompressed size, only an estimate for non-blocked gzip files */
+	[[nodiscard]] inline size_t GetSize() const noexcept
+	{
+		return m_File.GetSize();
+	}
+
+	/* Loads "<file>.fai" when it is up to date, otherwise builds it and tries to store it next to the file */
+	[[nodiscard]] const FastaIndex& GetIndex() const;
 
+	/* Residues [begin, end) of a record, end is clamped to the record length, BGZF files only inflate the blocks covering it */
+	[[nodiscard]] std::string_view Fetch(const std::string_view name, const uint64_t begin, const uint64_t end, std::string& buffer) const;
+
+	/* samtools style "name", "name:begin" or "name:begin-end" (one based, inclusive) */
+	[[nodiscard]] std::optional<FastaRegion> ParseRegion(const std::string_view region) const;
+private:
+	/* Bytes [begin, end) of the uncompressed file */
+	[[nodiscard]] std::string_view ReadBytes(const uint64_t begin, const uint64_t end, std::string& buffer) const;
+private:
+	SequenceFile m_File;
+	mutable std::optional<FastaIndex> m_Index;
+public:
 	static constexpr char s_Identifier{ '>' };
+	static constexpr size_t s_BatchSize{ 32U << 20U };	/* A record longer than this gets a batch of its own */
 };
\ No newline at end of file
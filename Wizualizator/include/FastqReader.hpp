@@ -0,0 +1,107 @@
+#pragma once
+#include "Core.hpp"
+#include "SequenceFile.hpp"
+
+/* Four line records, multi-line sequences aren't supported */
+struct FastqRecord
+{
+	std::string_view Name;
+	std::string_view Sequence;
+	std::string_view Quality;	/* Phred+33, one character per base */
+};
+
+/* Applied in order: 3' trimming first, then the length and quality limits on what's left */
+struct FastqFilter
+{
+	uint8_t TrimQuality{ 0U };			/* 3' ends are trimmed below this score (BWA algorithm), 0 disables trimming */
+	uint32_t MinimumLength{ 0U };		/* Shorter reads are dropped */
+	float MinimumMeanQuality{ 0.0f };	/* Reads with a lower mean score are dropped */
+
+	/* The trimmed read, std::nullopt when it's dropped */
+	[[nodiscard]] std::optional<FastqRecord> Apply(const FastqRecord& record) const noexcept;
+};
+
+/* Everything is counted per read position or per value, memory doesn't grow with the number of reads */
+class FastqStatistics
+{
+public:
+	static constexpr size_t s_QualityCount{ 94U };	/* Phred scores 0 - 93 ('!' - '~') */
+	using QualityHistogram = std::array<uint64_t, s_QualityCount>;
+
+	FastqStatistics() noexcept = default;
+	~FastqStatistics() noexcept = default;
+
+	void Add(const FastqRecord& record);
+	FastqStatistics& operator+=(const FastqStatistics& other);
+
+	[[nodiscard]] std::optional<float> GetMeanQuality() const noexcept;
+	[[nodiscard]] std::optional<float> GetMeanQuality(const size_t position) const noexcept;
+
+	[[nodiscard]] inline uint64_t GetReadCount() const noexcept
+	{
+		return m_ReadCount;
+	}
+
+	[[nodiscard]] inline uint64_t GetBaseCount() const noexcept
+	{
+		return m_BaseCount;
+	}
+
+	/* Score histogram of every base position */
+	[[nodiscard]] inline const std::vector<QualityHistogram>& GetPositionHistograms() const noexcept
+	{
+		return m_PositionHistograms;
+	}
+
+	/* Read count indexed by read length */
+	[[nodiscard]] inline const std::vector<uint64_t>& GetLengthDistribution() const noexcept
+	{
+		return m_LengthDistribution;
+	}
+
+	/* Read count indexed by the rounded mean score of the read */
+	[[nodiscard]] inline const QualityHistogram& GetReadQualityDistribution() const noexcept
+	{
+		return m_ReadQualityDistribution;
+	}
+private:
+	uint64_t m_ReadCount{ 0U };
+	uint64_t m_BaseCount{ 0U };
+	uint64_t m_QualitySum{ 0U };
+
+	std::vector<QualityHistogram> m_PositionHistograms;
+	std::vector<uint64_t> m_LengthDistribution;
+	QualityHistogram m_ReadQualityDistribution{};
+};
+
+class FastqReader
+{
+private:
+	NON_COPYABLE(FastqReader)
+public:
+	explicit FastqReader(const std::filesystem::path& path);
+	~FastqReader() noexcept = default;
+
+	/* ".fastq", ".fq" and their ".gz" variants */
+	[[nodiscard]] static bool HasFastqExtension(const std::filesystem::path& path);
+
+	/* Uncompressed size, only an estimate for non-blocked gzip files */
+	[[nodiscard]] inline size_t GetSize() const noexcept
+	{
+		return m_File.GetSize();
+	}
+
+	/*
+	* Single pass, statistics cover every read as stored and the reads passing the filter are handed over trimmed
+	* Accepted reads come in batches of up to s_BatchSize in the file order, they are only valid during the call
+	* A stop request ends the scan at the next read, the statistics then only cover the reads before it
+	*/
+	FastqStatistics Scan(const FastqFilter& filter, const std::function<void(std::span<const FastqRecord> records)>& onAccepted, const std::stop_token& stopToken = {}) const;
+private:
+	SequenceFile m_File;
+public:
+	static constexpr char s_Identifier{ '@' };
+	static constexpr char s_Separator{ '+' };
+	static constexpr char s_QualityOffset{ '!' };
+	static constexpr size_t s_BatchSize{ 4096U };
+};
\ No newline at end of file
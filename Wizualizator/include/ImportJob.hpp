@@ -0,0 +1,192 @@
+#pragma once
+#include "Core.hpp"
+#include "Project.hpp"
+
+/*
+* File import running on its own thread
+* The worker never touches the project, it posts tasks which the main thread runs between frames
+*/
+class ImportJob
+{
+private:
+	NON_COPYABLE(ImportJob)
+public:
+	using Work = std::function<void(ImportJob& job)>;
+	using FileWork = std::function<uint64_t(const std::filesystem::path& path)>;	/* Returns the number of records imported */
+
+	enum class EFileState : uint8_t
+	{
+		Queued,
+		Importing,
+		Imported,
+		Failed,
+		Cancelled
+	};
+
+	/* Written by the workers, read by the main thread */
+	struct FileProgress
+	{
+		std::filesystem::path Path;
+		std::atomic<EFileState> State{ EFileState::Queued };
+		std::atomic<uint64_t> Records{ 0U };
+	};
+
+	ImportJob(std::string&& name, Work&& work, std::vector<std::filesystem::path>&& files);
+	~ImportJob() noexcept;
+
+	/* Batch jobs list their files up front, the work then imports them through ForEachFile */
+	static void Launch(std::string name, Work&& work, std::vector<std::filesystem::path> files = {});
+
+	/* Main thread only, runs the posted tasks and drops finished jobs */
+	static void Update();
+
+	/* Blocks until every worker stopped, queued results are thrown away */
+	static void CancelAll() noexcept;
+
+	[[nodiscard]] static inline const std::vector<std::unique_ptr<ImportJob>>& GetJobs() noexcept
+	{
+		return s_Jobs;
+	}
+
+	/* Worker side */
+	void Post(std::function<void()>&& task);
+
+	/* Batch files add their sizes as they are opened */
+	inline void AddTotalBytes(const uint64_t totalBytes) noexcept
+	{
+		m_TotalBytes += totalBytes;
+	}
+
+	inline void AddProgress(const uint64_t bytes, const uint64_t records) noexcept
+	{
+		m_ProcessedBytes += bytes;
+		m_ProcessedRecords += records;
+	}
+
+	[[nodiscard]] inline bool IsCancelled() const noexcept
+	{
+		return m_StopSource.stop_requested();
+	}
+
+	/* For the readers, which check it between records */
+	[[nodiscard]] inline std::stop_token GetStopToken() const noexcept
+	{
+		return m_StopSource.get_token();
+	}
+
+	/* Files are spread over all cores, a failing file is logged and the others go on */
+	void ForEachFile(const FileWork& importFile);
+
+	/*
+	* Creates the sequences on all cores in batches, each batch is registered by one task so the input order is kept
+	* Cancellation is checked per input, the batch in flight is dropped
+	* Returns the number of sequences handed over for registration
+	*/
+	template<typename SequenceMetadataType, typename Input, typename Factory, typename Measure>
+	size_t CreateSequences(const std::span<const Input> inputs, const Factory& factory, const Measure& measure)
+	{
+		size_t createdCount{ 0U };
+		for (size_t batchBegin{ 0U }; batchBegin < inputs.size() && !IsCancelled(); batchBegin += s_BatchSize)
+		{
+			const auto first{ inputs.begin() + batchBegin };
+			const auto last{ inputs.begin() + std::min(batchBegin + s_BatchSize, inputs.size()) };
+
+			std::vector<SequenceMetadataType> sequences(static_cast<size_t>(last - first));
+			std::exception_ptr firstException{ nullptr };
+			std::mutex exceptionMutex;
+
+			std::transform(std::execution::par, first, last, sequences.begin(), [&](const Input& input) -> SequenceMetadataType
+			{
+				if (IsCancelled())
+					return {};
+
+				try
+				{
+					SequenceMetadataType sequence{ factory(input) };
+					AddProgress(measure(input), 1U);
+					return sequence;
+				}
+				catch (...)
+				{
+					const std::lock_guard<std::mutex> lock{ exceptionMutex };
+					if (!firstException)
+						firstException = std::current_exception();
+
+					return {};
+				}
+			});
+
+			BIO_UNLIKELY
+			if (firstException)
+				std::rethrow_exception(firstException);
+
+			if (IsCancelled())
+				break;
+
+			createdCount += sequences.size();
+			Post([sequences = std::move(sequences)]() mutable
+			{
+				for (SequenceMetadataType& sequence : sequences)
+					Project::RegisterSequence(std::move(sequence));
+			});
+		}
+
+		return createdCount;
+	}
+
+	/* Main thread side */
+	inline void Cancel() noexcept
+	{
+		m_StopSource.request_stop();
+	}
+
+	[[nodiscard]] inline const std::string& GetName() const noexcept
+	{
+		return m_Name;
+	}
+
+	[[nodiscard]] inline uint64_t GetTotalBytes() const noexcept
+	{
+		return m_TotalBytes;
+	}
+
+	[[nodiscard]] inline uint64_t GetProcessedBytes() const noexcept
+	{
+		return m_ProcessedBytes;
+	}
+
+	[[nodiscard]] inline uint64_t GetProcessedRecords() const noexcept
+	{
+		return m_ProcessedRecords;
+	}
+
+	/* Share of the files done for batches, of the bytes otherwise */
+	[[nodiscard]] float GetProgress() const noexcept;
+
+	[[nodiscard]] inline const std::vector<FileProgress>& GetFiles() const noexcept
+	{
+		return m_Files;
+	}
+private:
+	/* True once the worker is done and everything it posted has run */
+	bool RunPostedTasks();
+private:
+	std::string m_Name;
+
+	std::atomic<uint64_t> m_TotalBytes{ 0U };
+	std::atomic<uint64_t> m_ProcessedBytes{ 0U };
+	std::atomic<uint64_t> m_ProcessedRecords{ 0U };
+	std::stop_source m_StopSource;
+	std::atomic<bool> m_Finished{ false };
+
+	std::mutex m_TaskMutex;
+	std::vector<std::function<void()>> m_Tasks;
+
+	std::vector<FileProgress> m_Files;	/* Sized once before the worker starts */
+
+	/* Declared last, the worker starts once everything above is constructed */
+	std::thread m_Worker;
+
+	static constexpr size_t s_BatchSize{ 256U };
+	static inline std::vector<std::unique_ptr<ImportJob>> s_Jobs;
+};
\ No newline at end of file
@@ -0,0 +1,126 @@
+#pragma once
+#include "Core.hpp"
+
+/*
+* Least recently used store bounded by a byte budget, the caller reports the size of every value through Resize
+* Values live in list nodes and never move, pointers to them stay valid until they are evicted or erased
+* The most recently used value is never evicted, even when it alone is over the budget
+*/
+template<typename KeyType, typename ValueType>
+class LruCache
+{
+private:
+	struct Entry
+	{
+		KeyType Key;
+		ValueType Value;
+		size_t Size;
+
+		template<typename... Args>
+		Entry(const KeyType& key, Args&&... args)
+			:
+			Key{ key },
+			Value(std::forward<Args>(args)...),
+			Size{ 0U }
+		{}
+	};
+public:
+	explicit LruCache(const size_t budget) noexcept
+		:
+		m_Budget{ budget }
+	{}
+
+	/* Marks the value as the most recently used one, nullptr when it's not cached */
+	[[nodiscard]] ValueType* Find(const KeyType& key) noexcept
+	{
+		const auto entry{ m_Lookup.find(key) };
+		if (entry == m_Lookup.end())
+			return nullptr;
+
+		m_Entries.splice(m_Entries.begin(), m_Entries, entry->second);
+		return &entry->second->Value;
+	}
+
+	/* Replaces a cached value of the same key, the new value counts as empty until resized */
+	template<typename... Args>
+	ValueType& Emplace(const KeyType& key, Args&&... args)
+	{
+		Erase(key);
+
+		m_Entries.emplace_front(key, std::forward<Args>(args)...);
+		m_Lookup.emplace(key, m_Entries.begin());
+		return m_Entries.front().Value;
+	}
+
+	/* Also marks the value as the most recently used one, then evicts the least recently used ones until the budget holds */
+	void Resize(const KeyType& key, const size_t size) noexcept
+	{
+		const auto entry{ m_Lookup.find(key) };
+		if (entry == m_Lookup.end())
+			return;
+
+		m_Size = m_Size - entry->second->Size + size;
+		entry->second->Size = size;
+		m_Entries.splice(m_Entries.begin(), m_Entries, entry->second);
+
+		while (m_Size > m_Budget && m_Entries.size() > 1U)
+			EraseEntry(std::prev(m_Entries.end()));
+	}
+
+	void Erase(const KeyType& key) noexcept
+	{
+		if (const auto entry{ m_Lookup.find(key) }; entry != m_Lookup.end())
+			EraseEntry(entry->second);
+	}
+
+	/* predicate(const KeyType&) */
+	template<typename Predicate>
+	void EraseIf(Predicate predicate)
+	{
+		for (auto entry{ m_Entries.begin() }; entry != m_Entries.end();)
+		{
+			const auto next{ std::next(entry) };
+			if (predicate(std::as_const(entry->Key)))
+				EraseEntry(entry);
+
+			entry = next;
+		}
+	}
+
+	/* visitor(const KeyType&, const ValueType&), most recently used first, the order is left as it is */
+	template<typename Visitor>
+	void ForEach(Visitor visitor) const
+	{
+		for (const Entry& entry : m_Entries)
+			visitor(entry.Key, entry.Value);
+	}
+
+	void Clear() noexcept
+	{
+		m_Lookup.clear();
+		m_Entries.clear();
+		m_Size = 0U;
+	}
+
+	[[nodiscard]] size_t Size() const noexcept
+	{
+		return m_Size;
+	}
+
+	[[nodiscard]] size_t Count() const noexcept
+	{
+		return m_Entries.size();
+	}
+private:
+	std::list<Entry> m_Entries;	/* Most recently used first */
+	std::map<KeyType, typename std::list<Entry>::iterator> m_Lookup;
+	size_t m_Size{ 0U };
+	size_t m_Budget;
+
+	void EraseEntry(const typename std::list<Entry>::iterator entry) noexcept
+	{
+		m_Size -= entry->Size;
+		m_Lookup.erase(entry->Key);
+		m_Entries.erase(entry);
+	}
+};
\ No newline at end of file
@@ -16,6 +16,7 @@ private:
 		const std::string_view tooltip,
 		const std::string_view sequenceChildrenLabel,
 		const std::vector<Bio::AminoSequence>& candidates,
+		const std::vector<Bio::CodingPotential>& codingPotentials,
 		const ID frameIndex);
 	
 	void DrawPeptideSequence(
@@ -27,5 +28,7 @@ private:
 		const Bio::AminoSequence& peptide);
 private:
 	std::string m_SearchFilter;
+	float m_MinimumCodingPotential{ 0.0f };	/* TESTCODE filter of protein candidates */
+	bool m_RankByCodingPotential{ false };
 	std::vector<ID> m_ToRemove;
 };
\ No newline at end of file
@@ -16,4 +16,7 @@ public:
 private:
 	void DrawDirectoryFromRoot(const std::filesystem::path& rootPath, const std::string_view filter, const AssetCallbackFunction& function);
 	void DrawDirectoriesRecursively(const std::filesystem::path& directoryPath, const std::string_view filter, const AssetCallbackFunction& function);
+	void UpdateSelection(const std::filesystem::path& path);
+private:
+	std::set<std::filesystem::path> m_SelectedPaths;	/* Files and directories, dragged together as one batch */
 };
\ No newline at end of file
@@ -1,12 +1,24 @@
 #pragma once
 #include "Core.hpp"
 #include "ID.hpp"
+#include "SequenceRegistry.hpp"
+#include "LruCache.hpp"
 #include "Nucleotides.hpp"
 #include "Elements.hpp"
 #include "Hydropathy.hpp"
+#include "CodingPotential.hpp"
+
+class MappedFile;
 
 constexpr size_t g_FrameCount{ 3U };
 
+/* Settings the frames are calculated with, imports copy them at launch so their workers never read the live ones */
+struct FrameSettings
+{
+	Bio::OpenReadingFrameFlags OpenReadingFrameFlags{ Bio::OpenReadingFrameFlags_None };
+	std::shared_ptr<const Bio::HexamerTable> HexamerTable;	/* Kept alive for the import even when a new table is loaded */
+};
+
 template<typename Derived>
 struct SequenceMetadata
 {
@@ -33,6 +45,27 @@ private:
 	friend Derived;
 };
 
+/*
+* The sequence is encoded once, frames +1 and +2 are sliced from it and frame 1 takes it over
+* Each frame is translated right after it's laid out, while its codons are still in cache
+*/
+template<typename Metadata, typename NucleotideSequence>
+inline void DeserializeFrames(Metadata& metadata, NucleotideSequence&& nucleotideSequence, const FrameSettings& settings)
+{
+	const std::shared_ptr<typename Metadata::FrameArray> frames{ std::make_shared<typename Metadata::FrameArray>() };
+	metadata.ContentHash = Bio::HashSequence(nucleotideSequence);
+
+	/* AUC GUU -> UCG UUA -> CGU UAU */
+	for (uint32_t frameIndex{ g_FrameCount - 1U }; frameIndex > 0U; --frameIndex)
+	{
+		const size_t offset{ std::min<size_t>(frameIndex, nucleotideSequence.size()) };
+		Metadata::DeserializeFrame((*frames)[frameIndex], NucleotideSequence(nucleotideSequence.begin() + offset, nucleotideSequence.end()), settings);
+	}
+
+	Metadata::DeserializeFrame((*frames)[0U], std::move(nucleotideSequence), settings);
+	metadata.Frames = frames;
+}
+
 struct RnaMetadata final : public SequenceMetadata<RnaMetadata>
 {
 	std::string SequenceName;
@@ -48,38 +81,54 @@ struct RnaMetadata final : public SequenceMetadata<RnaMetadata>
 		return SequenceName;
 	}
 
-	struct
+	struct Frame
 	{
 		Bio::RnaSequence RnaSequence;
 		Bio::AminoSequence AminoSequence;
 		std::vector<Bio::AminoSequence> ProteinCandidates;
-	} Frames[g_FrameCount];
+		std::vector<Bio::OpenReadingFrame> OpenReadingFrames;	/* Codon ranges of the protein candidates */
+		std::vector<Bio::CodingPotential> CodingPotentials;		/* Scores of the protein candidates */
+		std::vector<Bio::CodonUsage> CodonUsages;				/* Codon histograms of the protein candidates */
+		Bio::CodonUsage CodonUsage;								/* Codon histogram of the whole frame */
+		std::vector<Bio::OpenReadingFrame> OpenReadingFrameStarts;	/* Every start with its stop, the candidates are selected from them by the ORF flags */
+		std::vector<Bio::CodonUsage> StartCodonUsages;				/* Codon histograms of OpenReadingFrameStarts */
+
+		const Bio::RnaSequence& GetSequence() const
+		{
+			return RnaSequence;
+		}
+	};
+
+	using FrameArray = std::array<Frame, g_FrameCount>;
+
+	/* Sequences without frames (empty or not decoded yet) all point here */
+	static inline const std::shared_ptr<FrameArray>& EmptyFrames()
+	{
+		static const std::shared_ptr<FrameArray> s_EmptyFrames{ std::make_shared<FrameArray>() };
+		return s_EmptyFrames;
+	}
+
+	/* Shared by every registered sequence with the same content (see Project::ShareFrames), never written once built */
+	std::shared_ptr<FrameArray> Frames{ EmptyFrames() };
+	uint64_t ContentHash{ 0U };		/* Bio::HashSequence of the first frame */
 
-	static void DeserializeFrame(RnaMetadata& _this, const uint32_t index, const Bio::RnaSequence& nucleotide);
+	static void DeserializeFrame(Frame& frame, Bio::RnaSequence&& nucleotide, const FrameSettings& settings);
 
-	static inline RnaMetadata Create(const std::string& sequenceName, const std::string_view sequence)
+	/* Raw record text is accepted, line breaks are skipped while encoding */
+	static inline RnaMetadata Create(const std::string& sequenceName, const std::string_view sequence, const FrameSettings& settings)
 	{
 		RnaMetadata metaData{ sequenceName };
 
 		if (sequence.empty())
 			return metaData;
-		
-		/* Deserialize Frame 1 (0 offset) */
-		DeserializeFrame(metaData, 0, Bio::ConvertToRNA(sequence));
 
-		/* Deserialize Frame 1 (+1 offset) */
-		/* AUC GUU -> UCG UUA */
-		DeserializeFrame(metaData, 1, Bio::ConvertToRNA(sequence.substr(1U)));
-
-		/* Deserialize Frame 1 (+2 offset) */
-		/* UCG UUA -> CGU UAU */
-		DeserializeFrame(metaData, 2, Bio::ConvertToRNA(sequence.substr(2U)));
+		DeserializeFrames(metaData, Bio::EncodeRNA(sequence), settings);
 		return metaData;
 	}
 	
 	const auto& GetFrame(const EFrame frame) const
 	{
-		return Frames[static_cast<size_t>(frame)];
+		return (*Frames)[static_cast<size_t>(frame)];
 	}
 
 	const std::string BakeSequence(const EFrame frame) const
@@ -134,16 +183,40 @@ private:
 struct DnaMetadata final : public SequenceMetadata<DnaMetadata>
 {
 	std::string SequenceName;
-	struct
+	struct Frame
 	{
 		Bio::DnaSequence DnaSequence;
 		Bio::AminoSequence AminoSequence;
 		std::vector<Bio::AminoSequence> ProteinCandidates;
-	} Frames[g_FrameCount];
+		std::vector<Bio::OpenReadingFrame> OpenReadingFrames;	/* Codon ranges of the protein candidates */
+		std::vector<Bio::CodingPotential> CodingPotentials;		/* Scores of the protein candidates */
+		std::vector<Bio::CodonUsage> CodonUsages;				/* Codon histograms of the protein candidates */
+		Bio::CodonUsage CodonUsage;								/* Codon histogram of the whole frame */
+		std::vector<Bio::OpenReadingFrame> OpenReadingFrameStarts;	/* Every start with its stop, the candidates are selected from them by the ORF flags */
+		std::vector<Bio::CodonUsage> StartCodonUsages;				/* Codon histograms of OpenReadingFrameStarts */
+
+		const Bio::DnaSequence& GetSequence() const
+		{
+			return DnaSequence;
+		}
+	};
+
+	using FrameArray = std::array<Frame, g_FrameCount>;
+
+	/* Sequences without frames (empty or not decoded yet) all point here */
+	static inline const std::shared_ptr<FrameArray>& EmptyFrames()
+	{
+		static const std::shared_ptr<FrameArray> s_EmptyFrames{ std::make_shared<FrameArray>() };
+		return s_EmptyFrames;
+	}
+
+	/* Shared by every registered sequence with the same content (see Project::ShareFrames), never written once built */
+	std::shared_ptr<FrameArray> Frames{ EmptyFrames() };
+	uint64_t ContentHash{ 0U };		/* Bio::HashSequence of the first frame */
 
 	const auto& GetFrame(const EFrame frame) const
 	{
-		return Frames[static_cast<size_t>(frame)];
+		return (*Frames)[static_cast<size_t>(frame)];
 	}
 
 	const std::string& GetName() const
@@ -157,32 +230,17 @@ struct DnaMetadata final : public SequenceMetadata<DnaMetadata>
 		SequenceName(sequenceName)
 	{}
 
-	static void DeserializeFrame(DnaMetadata& _this, const uint32_t frameIndex, const Bio::DnaSequence& nucleotide);
+	static void DeserializeFrame(Frame& frame, Bio::DnaSequence&& nucleotide, const FrameSettings& settings);
 
-	static inline DnaMetadata Create(const std::string& sequenceName, const std::string_view sequence, const bool reverse = false)
+	/* Raw record text is accepted, line breaks are skipped while encoding */
+	static inline DnaMetadata Create(const std::string& sequenceName, const std::string_view sequence, const FrameSettings& settings, const bool reverse = false)
 	{
 		DnaMetadata metaData{ sequenceName };
 
 		if (sequence.empty())
 			return metaData;
 
-		/* Deserialize Frame 1 (0 offset) */
-		DeserializeFrame(metaData, 0U, reverse ? Bio::ConvertToDNAReversed(sequence) : Bio::ConvertToDNA(sequence));
-
-		/* Deserialize Frame 1 (+1 offset) */
-		/* AUC GUU -> UCG UUA */
-		DeserializeFrame(metaData, 1U, 
-			reverse ? 
-			Bio::ConvertToDNAReversed(sequence.substr(0U, sequence.size() - 1U)) :
-			Bio::ConvertToDNA(sequence.substr(1U)));
-
-		/* Deserialize Frame 1 (+2 offset) */
-		/* UCG UUA -> CGU UAU */
-		const std::string_view secondSequenceShift{ sequence.substr(2U) };
-		DeserializeFrame(metaData, 2U, 
-			reverse ? 
-			Bio::ConvertToDNAReversed(sequence.substr(0U, sequence.size() - 2U)) : 
-			Bio::ConvertToDNA(sequence.substr(2U)));
+		DeserializeFrames(metaData, reverse ? Bio::EncodeDNAReversed(sequence) : Bio::EncodeDNA(sequence), settings);
 		return metaData;
 	}
 
@@ -240,6 +298,7 @@ struct AminoMetadata final : public SequenceMetadata<AminoMetadata>
 	std::string SequenceName;
 	Bio::AminoSequence AminoSequence;
 	std::vector<Bio::AminoSequence> ProteinCandidates;
+	std::vector<Bio::OpenReadingFrame> OpenReadingFrameStarts;	/* Every M with its stop, the candidates are selected from them by the ORF flags */
 
 	const std::string& GetName() const
 	{
@@ -252,33 +311,14 @@ struct AminoMetadata final : public SequenceMetadata<AminoMetadata>
 		SequenceName(sequenceName)
 	{}
 
-	static inline AminoMetadata Create(const std::string& sequenceName, const std::string_view sequence)
+	static void DeserializeCandidates(AminoMetadata& _this, const FrameSettings& settings);
+
+	static inline AminoMetadata Create(const std::string& sequenceName, const std::string_view sequence, const FrameSettings& settings)
 	{
 		AminoMetadata metaData(sequenceName);
-		metaData.AminoSequence = Bio::ConvertToAminoSequence(sequence);
-
-		auto& aminoSequence{ metaData.AminoSequence };
-		auto& proteinCandidates{ metaData.ProteinCandidates };
-
-		for (uint32_t i{ 0U }; i < aminoSequence.size(); ++i)
-		{
-			char currentAmino{ aminoSequence[i].AsCharacter() };
-
-			/* Start */
-			if (currentAmino == 'M')
-			{
-				Bio::AminoSequence candidate;
-
-				do
-				{
-					candidate.emplace_back(Bio::AminoAcid{}.AssignCharacter(currentAmino));
-					++i;
-				} while (i < aminoSequence.size() && (currentAmino = aminoSequence[i].AsCharacter()) != '-');
-
-				proteinCandidates.emplace_back(std::move(candidate));
-			}
-		}
+		metaData.AminoSequence = Bio::EncodeAminoSequence(sequence);
 
+		DeserializeCandidates(metaData, settings);
 		return metaData;
 	}
 
@@ -322,6 +362,40 @@ struct AminoMetadata final : public SequenceMetadata<AminoMetadata>
 	}
 };
 
+/* Counts its changes, values calculated from it store the version they saw and are recalculated once it moves on */
+template<typename Type>
+class VersionedSetting
+{
+public:
+	constexpr VersionedSetting(const Type value) noexcept
+		:
+		m_Value{ value }
+	{}
+
+	[[nodiscard]] constexpr const Type& Get() const noexcept
+	{
+		return m_Value;
+	}
+
+	/* Never 0, a value stamped with 0 was never calculated */
+	[[nodiscard]] constexpr uint64_t GetVersion() const noexcept
+	{
+		return m_Version;
+	}
+
+	constexpr void Set(const Type value) noexcept
+	{
+		if (value == m_Value)
+			return;
+
+		m_Value = value;
+		++m_Version;
+	}
+private:
+	Type m_Value;
+	uint64_t m_Version{ 1U };
+};
+
 class Project
 {
 private:
@@ -339,27 +413,98 @@ public:
 	static std::unique_ptr<Project>& Create();
 	static std::unique_ptr<Project>& Get();
 private:
-	static ID GenerateUUID() noexcept;
+	/* Each type in its own dense array, SequenceTypes only carries sequences in and out of it */
+	static inline SequenceRegistry<DnaMetadata, RnaMetadata, AminoMetadata> s_SequenceRegistry;
+	/* Sequences registered from a file by name only, Section gives their stored (uncompressed) section so saves don't have to decode them */
+	struct PendingSequence
+	{
+		std::function<SequenceTypes()> Decode;
+		std::function<std::string()> Section;
+		uint32_t SectionType;
+		uint32_t SectionFlags;
+	};
+
+	static inline std::unordered_map<ID, PendingSequence> s_PendingSequences;
 
-	static inline std::unordered_map<ID, SequenceTypes> s_SequenceRegistry;
+	/* Called when Decode() throws, the sequence stays pending so saves don't replace its stored section with an empty one */
+	static void KeepUndecodedSequence(PendingSequence& pendingSequence);
+
+	/* Frames of registered nucleotide sequences by content hash, expired once the last sequence using them is gone */
+	static inline std::unordered_map<uint64_t, std::weak_ptr<DnaMetadata::FrameArray>> s_SharedDnaFrames;
+	static inline std::unordered_map<uint64_t, std::weak_ptr<RnaMetadata::FrameArray>> s_SharedRnaFrames;
+
+	/* Swaps the frames of a freshly registered sequence for the ones of an identical sequence (if there's any) */
+	static void ShareFrames(DnaMetadata& dnaMetadata);
+	static void ShareFrames(RnaMetadata& rnaMetadata);
+	static inline void ShareFrames(AminoMetadata&) noexcept {}
+
+	/* Replaces the frames of every decoded nucleotide sequence with copies the callback rebuilt, they may still be read by an autosave */
+	template<typename RebuildFrame>
+	static void RebuildFrames(const RebuildFrame& rebuildFrame);
+
+	/* Where sequences live in the binary file last opened or saved, lets the next save only append what changed */
+	struct SavedFile
+	{
+		std::filesystem::path Path;
+		std::unordered_map<ID, uint32_t> Slots;
+		uint32_t SlotCount{ 0U };
+		uint32_t Codec{ 0U };
+		uint64_t BaseSize{ 0U };
+		uint64_t JournalSize{ 0U };
+
+		void Clear()
+		{
+			Path.clear();
+			Slots.clear();
+			SlotCount	= 0U;
+			Codec		= 0U;
+			BaseSize	= 0U;
+			JournalSize = 0U;
+		}
+	};
+
+	static inline SavedFile s_SavedFile;
 	static inline std::vector<std::function<void()>>	m_SelectionContextUpdateCallbacks;
 	static inline bool									m_WasUpdated{ false };
+	static inline uint64_t								m_Revision{ 0U };	/* Bumped by every change, autosaves skip revisions they already wrote */
 public:
+	/* Registered under its name only, the metadata is replaced by Decode() the first time the sequence is used */
+	template<typename SequenceMetadataType>
+	static inline ID RegisterPendingSequence(const std::string& name, PendingSequence&& pendingSequence)
+	{
+		const ID uuid{ s_SequenceRegistry.Insert(SequenceMetadataType{ name }) };
+		s_PendingSequences[uuid] = std::move(pendingSequence);
+
+		m_WasUpdated = true;
+		++m_Revision;
+		return uuid;
+	}
+
+	static void MaterializeSequence(const ID uuid);
+
+	/* Decodes every pending sequence, needed before anything goes over the whole project (the ones that fail stay pending) */
+	static void MaterializeSequences();
+
+	/* Takes a fully built sequence, its frames are shared with an identical registered one */
 	template<typename SequenceMetadataType>
-	static inline SequenceTypes& RegisterSequence(const std::string& name)
+	static inline ID RegisterSequence(SequenceMetadataType&& metadata)
 	{
-		const ID uuid{ GenerateUUID() };
-		s_SequenceRegistry[uuid] = SequenceMetadataType{ name };
+		const ID uuid{ s_SequenceRegistry.Insert(std::forward<SequenceMetadataType>(metadata)) };
+		s_SequenceRegistry.Visit(uuid, [](auto& sequence) { ShareFrames(sequence); });
 
 		m_WasUpdated = true;
-		return s_SequenceRegistry[uuid];
+		++m_Revision;
+		return uuid;
 	}
 
 	static inline void UnregisterSequence(const ID uuid)
 	{
 		m_WasUpdated = true;
+		++m_Revision;
 		BIO_ASSERT(uuid != g_InvalidID);
-		s_SequenceRegistry.erase(uuid);
+		s_PendingSequences.erase(uuid);
+		s_SequenceRegistry.Erase(uuid);
+		EvictSelectionCaches(uuid);
 	}
 
 	static inline void SubscribeContextSelection(const std::function<void()> function)
@@ -372,6 +517,11 @@ public:
 		return m_WasUpdated;
 	}
 
+	static inline uint64_t GetRevision() noexcept
+	{
+		return m_Revision;
+	}
+
 	static inline void SetSaveStatus(const bool saved) noexcept
 	{
 		m_WasUpdated = !saved;
@@ -379,10 +529,11 @@ public:
 
 	static inline void ResetCache()
 	{
-		s_NucleotideSequenceCache.reset();
-		s_NucleotideSequencePeptideCache.reset();
-		s_AminoSequenceCache.reset();
-		s_AminoSequencePeptideCache.reset();
+		s_NucleotideSequenceCache		 = nullptr;
+		s_NucleotideSequencePeptideCache = nullptr;
+		s_AminoSequenceCache			 = nullptr;
+		s_AminoSequencePeptideCache		 = nullptr;
+		s_SelectionCaches.Clear();
 	}
 
 	static inline void Reset()
@@ -390,34 +541,27 @@ public:
 		m_WasUpdated = false;
 		ResetCache();	
 		s_SelectionContext.Clear();
-		s_SequenceRegistry.clear();
+		s_PendingSequences.clear();
+		s_SequenceRegistry.Clear();
+		s_SharedDnaFrames.clear();
+		s_SharedRnaFrames.clear();
+		s_SavedFile.Clear();
 	}
 
-	static inline SequenceTypes& GetSequence(const ID uuid)
+	/* Calls visitor with the sequence's metadata (DnaMetadata&, RnaMetadata& or AminoMetadata&), decoding it first if it's pending */
+	template<typename Visitor>
+	static inline decltype(auto) VisitSequence(const ID uuid, Visitor&& visitor)
 	{
-		BIO_ASSERT(uuid != g_InvalidID && s_SequenceRegistry.contains(uuid));
-		return s_SequenceRegistry[uuid];
+		BIO_ASSERT(uuid != g_InvalidID && s_SequenceRegistry.Contains(uuid));
+		MaterializeSequence(uuid);
+		return s_SequenceRegistry.Visit(uuid, std::forward<Visitor>(visitor));
 	}
 
-	struct SequenceIterator
-	{
-		std::unordered_map<ID, SequenceTypes>::const_iterator BeginIterator;
-		std::unordered_map<ID, SequenceTypes>::const_iterator EndIterator;
-
-		inline std::unordered_map<ID, SequenceTypes>::const_iterator begin() noexcept
-		{
-			return BeginIterator;
-		}
-
-		inline std::unordered_map<ID, SequenceTypes>::const_iterator end() noexcept
-		{
-			return EndIterator;
-		}
-	};
-
-	static inline SequenceIterator IterateSequences()
+	/* Calls visitor(ID, const Metadata&) for every sequence, grouped by type */
+	template<typename Visitor>
+	static inline void ForEachSequence(Visitor&& visitor)
 	{
-		return { s_SequenceRegistry.cbegin(), s_SequenceRegistry.cend() };
+		std::as_const(s_SequenceRegistry).ForEach(std::forward<Visitor>(visitor));
 	}
 
 	struct IsoelectricPointPlotData_t
@@ -441,13 +585,18 @@ public:
 	{
 		struct  
 		{
-			float PH{ 7.0f };
+			VersionedSetting<float> PH{ 7.0f };
 		} NetCharge;
 
 		struct
 		{
-			size_t WindowSize{ 3U };
+			VersionedSetting<size_t> WindowSize{ 3U };
 		} Hydropathy;
+
+		struct
+		{
+			Bio::OpenReadingFrameFlags Flags{ Bio::OpenReadingFrameFlags_None };
+		} OpenReadingFrames;
 	};
 
 	struct NucleotideSequenceCache
@@ -456,20 +605,27 @@ public:
 		std::string NucleotideSequence;
 		std::string AminoSequence;
 		std::size_t FrameIndex;
+		uint64_t ContentHash;	/* Of the amino sequence, key of the derived data cache */
 
 		std::vector<std::string> ProteinCandidates;
 		std::vector<std::uint32_t> ProteinCandidateLengths;
+		std::vector<Bio::CodingPotential> ProteinCandidateCodingPotentials;
 
 		/* Properties */
 		std::optional<double> MolecularWeight;
 		std::optional<double> IsoeletricPoint;
 		std::optional<double> NetCharge;
+		std::optional<float> CodonAdaptationIndex;
 
 		/* Structure */
 		std::optional<Bio::PeptideFormula> Formula;
 		/* Plot data */
 		std::optional<std::shared_ptr<IsoelectricPointPlotData_t>> IsoeletricPointPlotData;
 		std::optional<std::shared_ptr<HydropathyPlotData_t>> HydropathyPlotData;
+
+		/* Setting versions of the values depending on more than the sequence, which never changes for a cache */
+		uint64_t NetChargeVersion;		/* pH */
+		uint64_t HydropathyVersion;		/* Window size */
 	};
 
 	struct NucleotideSequencePeptideCache
@@ -480,11 +636,15 @@ public:
 		std::string ProteinCandidate;
 		std::string AminoSequenceThreeLetterCode;
 		std::size_t PeptideIndex;
+		uint64_t ContentHash;
 
 		/* Properties */
 		std::optional<double> MolecularWeight;
 		std::optional<double> IsoeletricPoint;
 		std::optional<double> NetCharge;
+		std::optional<Bio::CodingPotential> CodingPotential;
+		std::optional<Bio::CodonUsage> CodonUsage;
+		std::optional<float> CodonAdaptationIndex;
 		size_t ExtinctionCoefficient;
 		size_t ExtinctionCoefficientReduced;
 		/* Structure */
@@ -492,6 +652,10 @@ public:
 		/* Plot data */
 		std::optional<std::shared_ptr<IsoelectricPointPlotData_t>> IsoeletricPointPlotData;
 		std::optional<std::shared_ptr<HydropathyPlotData_t>> HydropathyPlotData;
+
+		/* Setting versions of the values depending on more than the sequence, which never changes for a cache */
+		uint64_t NetChargeVersion;		/* pH */
+		uint64_t HydropathyVersion;		/* Window size */
 	};
 
 	struct AminoSequenceCache
@@ -499,6 +663,7 @@ public:
 		std::string SequenceName;
 		std::string AminoSequence;
 		std::string AminoSequenceThreeLetterCode;
+		uint64_t ContentHash;
 
 		std::vector<std::string> ProteinCandidates;
 		std::vector<std::uint32_t> ProteinCandidateLengths;
@@ -514,6 +679,10 @@ public:
 		/* Plot data */
 		std::optional<std::shared_ptr<IsoelectricPointPlotData_t>> IsoeletricPointPlotData;
 		std::optional<std::shared_ptr<HydropathyPlotData_t>> HydropathyPlotData;
+
+		/* Setting versions of the values depending on more than the sequence, which never changes for a cache */
+		uint64_t NetChargeVersion;		/* pH */
+		uint64_t HydropathyVersion;		/* Window size */
 	};
 	
 	struct AminoSequencePeptideCache
@@ -525,6 +694,7 @@ public:
 		std::string AminoSequenceThreeLetterCode;
 
 		std::size_t PeptideIndex;
+		uint64_t ContentHash;
 
 		/* Properties */
 		std::optional<double> MolecularWeight;
@@ -537,20 +707,85 @@ public:
 		/* Plot data */
 		std::optional<std::shared_ptr<IsoelectricPointPlotData_t>> IsoeletricPointPlotData;
 		std::optional<std::shared_ptr<HydropathyPlotData_t>> HydropathyPlotData;
+
+		/* Setting versions of the values depending on more than the sequence, which never changes for a cache */
+		uint64_t NetChargeVersion;		/* pH */
+		uint64_t HydropathyVersion;		/* Window size */
 	};
 private:
 	constinit static inline CalculationSettingsContext s_CalculationContext;
+	static inline std::shared_ptr<const Bio::HexamerTable> s_HexamerTable;
+	static inline std::unique_ptr<const Bio::CodonAdaptationTable> s_CodonAdaptationTable;
 
-	static inline std::optional<NucleotideSequenceCache> s_NucleotideSequenceCache;
-	static inline std::optional<NucleotideSequencePeptideCache> s_NucleotideSequencePeptideCache;
+	/* Caches of the current selection, owned by s_SelectionCaches */
+	static inline NucleotideSequenceCache* s_NucleotideSequenceCache{ nullptr };
+	static inline NucleotideSequencePeptideCache* s_NucleotideSequencePeptideCache{ nullptr };
 
-	static inline std::optional<AminoSequenceCache> s_AminoSequenceCache;
-	static inline std::optional<AminoSequencePeptideCache> s_AminoSequencePeptideCache;
+	static inline AminoSequenceCache* s_AminoSequenceCache{ nullptr };
+	static inline AminoSequencePeptideCache* s_AminoSequencePeptideCache{ nullptr };
 public:
 	[[nodiscard]] static CalculationSettingsContext& GetCalculationContext() noexcept;
 	static void RecalculateHydropathy() noexcept;
 	static void RecalculateNetCharge() noexcept;
 
+	static void LoadHexamerTable(const std::filesystem::path& path);
+	static void RecalculateCodingPotentials();
+
+	/* Reselects the candidates of every sequence from its stored starts after the ORF flags changed */
+	static void RecalculateProteinCandidates();
+
+	[[nodiscard]] static inline const Bio::HexamerTable* GetHexamerTable() noexcept
+	{
+		return s_HexamerTable.get();
+	}
+
+	/* Main thread only, workers get a copy taken before they start */
+	[[nodiscard]] static inline FrameSettings GetFrameSettings()
+	{
+		return FrameSettings{ .OpenReadingFrameFlags{ s_CalculationContext.OpenReadingFrames.Flags }, .HexamerTable{ s_HexamerTable } };
+	}
+
+	static void LoadCodonAdaptationTable(const std::filesystem::path& path);
+	static void SetCodonAdaptationReference(const Bio::CodonUsage& reference);
+
+	/* Reduced over all frames of the project, optionally only over ORFs scored as coding */
+	[[nodiscard]] static Bio::CodonUsage CalculateCodonUsage(const bool likelyCodingOnly = false);
+
+	[[nodiscard]] static inline const Bio::CodonAdaptationTable* GetCodonAdaptationTable() noexcept
+	{
+		return s_CodonAdaptationTable.get();
+	}
+
+	struct ProteinExportFilter
+	{
+		uint32_t MinimumLength{ 0U };			/* Residues */
+		float MinimumCodingPotential{ 0.0f };	/* TESTCODE, candidates of peptide sequences have none and are kept */
+	};
+
+	/*
+	* Every protein candidate passing the filter as FASTA, sequences in creation order
+	* Headers read ">name_f<frame>_<index> name frame=<frame> nt=<begin>-<end> aa=<length> testcode=<score>", coordinates are one based on the imported strand
+	* Returns the number of proteins written
+	*/
+	static size_t ExportProteinCandidates(const std::filesystem::path& path, const ProteinExportFilter& filter);
+
+	enum class EPropertyExportFormat : uint8_t
+	{
+		Tsv,		/* Header line followed by tab separated rows */
+		JsonLines	/* One object per line */
+	};
+
+	/*
+	* Properties of every translated frame and protein candidate, one row each, sequences in creation order
+	* Columns: sequence, frame, orf, nt_begin, nt_end, length, molecular_weight, isoelectric_point, net_charge, extinction_coefficient, extinction_coefficient_reduced, formula
+	* Whole frames have orf 0, peptide sequences have frame 0 and no nucleotide coordinates, net charge is taken at the pH of the calculation settings
+	* Returns the number of rows written
+	*/
+	static size_t ExportProperties(const std::filesystem::path& path, const EPropertyExportFormat format);
+
+	/* Sorted hashes of every translation and protein candidate the derived data cache can hold results for, none while sequences are pending (they'd have to be decoded) */
+	[[nodiscard]] static std::optional<std::vector<uint64_t>> GetDerivedDataHashes();
+
 	[[maybe_unused]] static bool OnSequenceSelected(
 		const std::function<void(const NucleotideSequenceCache&)> onNucleotideSequenceSelected					= nullptr,
 		const std::function<void(const NucleotideSequencePeptideCache&)> onNucleotideSequencePeptideSelected	= nullptr,
@@ -580,6 +815,37 @@ private:
 			Peptide	 = g_InvalidID;
 		}
 	} inline static s_SelectionContext{};
+
+	struct SelectionCacheKey
+	{
+		ESequenceSelectionType Type;
+		ID Sequence;
+		ID Frame;
+
+		auto operator<=>(const SelectionCacheKey&) const = default;
+	};
+
+	/* Peptide caches keep a reference to SequenceCache, entries never move once cached */
+	template<typename SequenceCacheType, typename PeptideCacheType>
+	struct SelectionCacheEntry
+	{
+		SequenceCacheType SequenceCache;
+		std::map<ID, PeptideCacheType> PeptideCaches;
+	};
+
+	using NucleotideSelectionCacheEntry = SelectionCacheEntry<NucleotideSequenceCache, NucleotideSequencePeptideCache>;
+	using AminoSelectionCacheEntry		= SelectionCacheEntry<AminoSequenceCache, AminoSequencePeptideCache>;
+
+	/* Recently viewed selections, switching back to one of them restores its results instead of recalculating them */
+	static constexpr size_t s_SelectionCacheBudget{ 256U * 1024U * 1024U };
+	static inline LruCache<SelectionCacheKey, std::variant<NucleotideSelectionCacheEntry, AminoSelectionCacheEntry>> s_SelectionCaches{ s_SelectionCacheBudget };
+
+	[[nodiscard]] static inline SelectionCacheKey SelectedCacheKey() noexcept
+	{
+		return SelectionCacheKey{ .Type{ s_SelectionContext.Type }, .Sequence{ s_SelectionContext.Sequence }, .Frame{ s_SelectionContext.Frame } };
+	}
+
+	static void EvictSelectionCaches(const ID sequenceID);
 public:
 	static void InvalidateSelectionContext(
 		const ESequenceSelectionType selectionType, 
@@ -611,6 +877,8 @@ private:
 	static void SetPathCallback(const std::function<std::filesystem::path()> callback) noexcept;
 private:
 	friend class ProjectSerializer;
+	friend class ProjectSnapshot;
+	friend class AutosaveJob;
 	friend class Wizualizator;
 	friend class ContentPanel;
 	friend class PlotPanel;
@@ -618,6 +886,22 @@ private:
 	friend class StructurePanel;
 };
 
+/* Copy of the registry a project file can be written from on any thread, nucleotide frames are shared instead of copied */
+class ProjectSnapshot
+{
+private:
+	struct Sequence
+	{
+		ID UUID;
+		Project::SequenceTypes Metadata;
+		std::optional<Project::PendingSequence> PendingSequence;	/* Written from its stored section */
+	};
+
+	std::vector<Sequence> m_Sequences;	/* Creation order */
+private:
+	friend class ProjectSerializer;
+};
+
 class ProjectSerializer
 {
 private:
@@ -626,8 +910,35 @@ public:
 	explicit ProjectSerializer(std::unique_ptr<Project>& project) noexcept;
 	~ProjectSerializer() noexcept = default;
 
-	void OnSerialize(const std::filesystem::path& path) const;
+	/*
+	* Always writes the whole binary format through WriteSnapshot, ORF coordinates are only stored with storeDerivedData (otherwise they're rescanned on load)
+	* Both saves report their errors and return false, the file from the last successful save is left as it was
+	*/
+	[[nodiscard]] bool OnSerialize(const std::filesystem::path& path, const bool storeDerivedData = true) const;
+
+	/* Appends added and removed sequences when saving over the file from the last open / save, otherwise (or once the journal grows too big) serializes */
+	[[nodiscard]] bool OnSave(const std::filesystem::path& path) const;
+
+	/* Main thread, cheap enough to run between frames (peptides are the only sequences copied) */
+	[[nodiscard]] static ProjectSnapshot TakeSnapshot();
+
+	/* Any thread, the file is written next to path and renamed over it once complete, so path always holds a whole project (returns WriteBinary's size) */
+	static uint64_t WriteSnapshot(const ProjectSnapshot& snapshot, const std::filesystem::path& path, const bool storeDerivedData = true);
+
+	/*
+	* Binary files are recognized by their magic, anything else is read as the (version 1) text format
+	* Binary sequences are only registered by name, their sections are decoded from the mapped file on first use
+	*/
 	void OnDeserialize(const std::filesystem::path& path);
+private:
+	void DeserializeText(const std::string_view file);
+	void DeserializeBinary(const std::shared_ptr<const MappedFile> mappedFile);
+
+	/* Returns the size of the header, table and sections */
+	static uint64_t WriteBinary(std::ofstream& output, const ProjectSnapshot& snapshot, const bool storeDerivedData);
+
+	/* One '#' line with everything up to the next one */
+	[[nodiscard]] static Project::SequenceTypes ReadTextSection(const std::string_view section);
 private:
 	std::unique_ptr<Project>& m_Project;
 
@@ -0,0 +1,154 @@
+#pragma once
+#include "Core.hpp"
+#include "MappedFile.hpp"
+#include "GzipFile.hpp"
+
+/* Line breaks of CRLF files leave a '\r' behind */
+[[nodiscard]] inline std::string_view TrimLineEnd(std::string_view line) noexcept
+{
+	if (!line.empty() && line.back() == '\r')
+		line.remove_suffix(1U);
+
+	return line;
+}
+
+/* Walks a text line by line, shared by the record parsers of every format */
+class LineReader
+{
+public:
+	LineReader() noexcept = default;
+	explicit LineReader(const std::string_view text) noexcept
+		:
+		m_Text(text),
+		m_Position(0U)
+	{}
+
+	[[nodiscard]] inline bool IsAtEnd() const noexcept
+	{
+		return m_Position >= m_Text.size();
+	}
+
+	/* Offset of the next line, the line break of the last line is counted even when the text lacks it */
+	[[nodiscard]] inline size_t GetPosition() const noexcept
+	{
+		return m_Position;
+	}
+
+	/* Lets a line be read again */
+	inline void Seek(const size_t position) noexcept
+	{
+		m_Position = position;
+	}
+
+	/* Next line without its line break, an empty view past the end */
+	inline std::string_view NextLine() noexcept
+	{
+		if (IsAtEnd())
+			return {};
+
+		size_t lineEnd{ m_Text.find('\n', m_Position) };
+		if (lineEnd == std::string_view::npos)
+			lineEnd = m_Text.size();
+
+		const std::string_view line{ TrimLineEnd(m_Text.substr(m_Position, lineEnd - m_Position)) };
+		m_Position = lineEnd + 1U;
+		return line;
+	}
+private:
+	std::string_view m_Text{};
+	size_t m_Position{ 0U };
+};
+
+/* Input of the FASTA and FASTQ readers, gzip and BGZF files are recognized by their magic bytes whatever the extension */
+class SequenceFile
+{
+private:
+	NON_COPYABLE(SequenceFile)
+public:
+	explicit SequenceFile(const std::filesystem::path& path);
+	~SequenceFile() noexcept = default;
+
+	/* Compared case insensitively after a ".gz" extension is stripped */
+	[[nodiscard]] static bool HasExtension(const std::filesystem::path& path, const std::initializer_list<std::string_view> extensions);
+
+	/* Uncompressed size, only an estimate for non-blocked gzip files */
+	[[nodiscard]] inline size_t GetSize() const noexcept
+	{
+		return m_CompressedFile ? m_CompressedFile->GetSize() : m_File.GetSize();
+	}
+
+	/* Only set for gzip input */
+	[[nodiscard]] inline const GzipFile* GetCompressedFile() const noexcept
+	{
+		return m_CompressedFile.get();
+	}
+
+	/* Raw bytes as stored */
+	[[nodiscard]] inline std::string_view GetMappedView() const noexcept
+	{
+		return m_File.GetView();
+	}
+
+	[[nodiscard]] inline const std::filesystem::path& GetPath() const noexcept
+	{
+		return m_Path;
+	}
+private:
+	MappedFile m_File;
+	std::unique_ptr<GzipFile> m_CompressedFile;	/* Only set for gzip input, which m_File then maps */
+	std::filesystem::path m_Path;
+};
+
+/*
+* Front to back pass over a sequence file, only the window between the consumed and the read bytes is held
+* Plain files are served straight from the mapping, gzip files are inflated a chunk at a time
+*/
+class FileWindow
+{
+private:
+	NON_COPYABLE(FileWindow)
+public:
+	explicit FileWindow(const SequenceFile& file);
+	~FileWindow() noexcept = default;
+
+	/* Bytes read but not consumed yet, valid until the next Extend */
+	[[nodiscard]] inline std::string_view GetView() const noexcept
+	{
+		return m_Stream ? std::string_view{ m_Buffer }.substr(m_Consumed) : m_File.GetMappedView().substr(m_Consumed);
+	}
+
+	/* Offset of the view in the uncompressed file */
+	[[nodiscard]] inline uint64_t GetOffset() const noexcept
+	{
+		return m_Offset + m_Consumed;
+	}
+
+	/* The view runs up to the end of the file */
+	[[nodiscard]] inline bool IsAtEnd() const noexcept
+	{
+		return !m_Stream || m_Stream->IsAtEnd();
+	}
+
+	/* Drops the consumed bytes and reads the next chunk, false at the end of the file */
+	bool Extend();
+
+	inline void Consume(const size_t size) noexcept
+	{
+		m_Consumed += size;
+	}
+
+	/* Whole lines of the view, the last line is only left out when the file goes on */
+	[[nodiscard]] inline std::string_view GetLines() const noexcept
+	{
+		const std::string_view view{ GetView() };
+		return IsAtEnd() ? view : view.substr(0U, view.rfind('\n') + 1U);
+	}
+private:
+	const SequenceFile& m_File;
+	std::unique_ptr<GzipFile::Stream> m_Stream;	/* Only set for gzip input */
+	std::string m_Buffer;
+	uint64_t m_Offset;	/* Of the buffer in the uncompressed file */
+	size_t m_Consumed;
+public:
+	static constexpr size_t s_ChunkSize{ 4U << 20U };
+};
\ No newline at end of file
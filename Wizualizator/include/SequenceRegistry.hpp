@@ -0,0 +1,220 @@
+#pragma once
+#include "Core.hpp"
+#include "ID.hpp"
+
+/*
+* Generational slot map of the project's sequences
+* An ID holds the index of its slot in the low 32 bits and the generation of the slot in the high ones, the ID of a removed sequence never becomes valid again
+* Every type is kept in its own dense array, removal moves the last sequence of that array into the gap
+*/
+template<typename... Types>
+class SequenceRegistry
+{
+private:
+	struct Slot
+	{
+		uint32_t Generation;
+		uint32_t Index;		/* Into the dense array of the type, the next free slot while unused */
+		uint32_t Type;		/* Position in Types, s_FreeType while unused */
+		uint64_t Creation;	/* Registration counter, restores the creation order */
+	};
+
+	template<typename Type>
+	struct DenseArray
+	{
+		std::vector<Type> Values;
+		std::vector<uint32_t> Slots;	/* Slot of every value, followed when the last value fills a gap */
+	};
+public:
+	template<typename Type>
+	ID Insert(Type&& value)
+	{
+		using ValueType = std::decay_t<Type>;
+		DenseArray<ValueType>& array{ std::get<DenseArray<ValueType>>(m_Arrays) };
+
+		uint32_t slotIndex{ m_FreeSlot };
+		if (slotIndex != s_NoSlot)
+			m_FreeSlot = m_Slots[slotIndex].Index;
+		else
+		{
+			slotIndex = static_cast<uint32_t>(m_Slots.size());
+			m_Slots.push_back(Slot{ .Generation{ 1U }, .Index{ 0U }, .Type{ s_FreeType }, .Creation{ 0U } });
+		}
+
+		Slot& slot{ m_Slots[slotIndex] };
+		slot.Index = static_cast<uint32_t>(array.Values.size());
+		slot.Type = IndexOf<ValueType>();
+		slot.Creation = ++m_CreationCounter;
+
+		array.Values.push_back(std::forward<Type>(value));
+		array.Slots.push_back(slotIndex);
+
+		return MakeID(slotIndex, slot.Generation);
+	}
+
+	void Erase(const ID id) noexcept
+	{
+		BIO_UNLIKELY
+		if (!Contains(id))
+			return;
+
+		const uint32_t slotIndex{ static_cast<uint32_t>(id) };
+		EraseValue(m_Slots[slotIndex]);
+
+		Slot& slot{ m_Slots[slotIndex] };
+		++slot.Generation;
+		slot.Type = s_FreeType;
+		slot.Index = m_FreeSlot;
+		m_FreeSlot = slotIndex;
+	}
+
+	/* Slots are kept, IDs handed out before stay invalid */
+	void Clear() noexcept
+	{
+		std::apply([](auto&... arrays) { ((arrays.Values.clear(), arrays.Slots.clear()), ...); }, m_Arrays);
+
+		m_FreeSlot = s_NoSlot;
+		for (size_t i{ m_Slots.size() }; i > 0U; --i)
+		{
+			Slot& slot{ m_Slots[i - 1U] };
+			if (slot.Type != s_FreeType)
+				++slot.Generation;
+
+			slot.Type = s_FreeType;
+			slot.Index = m_FreeSlot;
+			m_FreeSlot = static_cast<uint32_t>(i - 1U);
+		}
+	}
+
+	[[nodiscard]] bool Contains(const ID id) const noexcept
+	{
+		const uint32_t slotIndex{ static_cast<uint32_t>(id) };
+		return slotIndex < m_Slots.size() && m_Slots[slotIndex].Type != s_FreeType && m_Slots[slotIndex].Generation == static_cast<uint32_t>(id >> 32U);
+	}
+
+	[[nodiscard]] size_t Size() const noexcept
+	{
+		return std::apply([](const auto&... arrays) { return (arrays.Values.size() + ...); }, m_Arrays);
+	}
+
+	/* Calls visitor(Type&) with the sequence, the ID has to be valid */
+	template<typename Visitor>
+	decltype(auto) Visit(const ID id, Visitor&& visitor)
+	{
+		BIO_ASSERT(Contains(id));
+		return VisitValue(m_Arrays, m_Slots[static_cast<uint32_t>(id)], visitor);
+	}
+
+	template<typename Visitor>
+	decltype(auto) Visit(const ID id, Visitor&& visitor) const
+	{
+		BIO_ASSERT(Contains(id));
+		return VisitValue(m_Arrays, m_Slots[static_cast<uint32_t>(id)], visitor);
+	}
+
+	/* Calls visitor(ID, Type&) for every sequence, array by array in the order of Types */
+	template<typename Visitor>
+	void ForEach(Visitor&& visitor)
+	{
+		std::apply([this, &visitor](auto&... arrays) { (ForEachValue(arrays, visitor), ...); }, m_Arrays);
+	}
+
+	template<typename Visitor>
+	void ForEach(Visitor&& visitor) const
+	{
+		std::apply([this, &visitor](const auto&... arrays) { (ForEachValue(arrays, visitor), ...); }, m_Arrays);
+	}
+
+	template<typename Type>
+	[[nodiscard]] std::vector<Type>& GetValues() noexcept
+	{
+		return std::get<DenseArray<Type>>(m_Arrays).Values;
+	}
+
+	template<typename Type>
+	[[nodiscard]] const std::vector<Type>& GetValues() const noexcept
+	{
+		return std::get<DenseArray<Type>>(m_Arrays).Values;
+	}
+
+	[[nodiscard]] std::vector<ID> GetIDsInCreationOrder() const
+	{
+		std::vector<std::pair<uint64_t, ID>> sequences;
+		sequences.reserve(Size());
+		for (size_t slotIndex{ 0U }; slotIndex < m_Slots.size(); ++slotIndex)
+			if (m_Slots[slotIndex].Type != s_FreeType)
+				sequences.emplace_back(m_Slots[slotIndex].Creation, MakeID(static_cast<uint32_t>(slotIndex), m_Slots[slotIndex].Generation));
+
+		std::sort(sequences.begin(), sequences.end());
+
+		std::vector<ID> ids(sequences.size());
+		std::transform(sequences.begin(), sequences.end(), ids.begin(), [](const std::pair<uint64_t, ID>& sequence)
+		{
+			return sequence.second;
+		});
+
+		return ids;
+	}
+private:
+	static constexpr uint32_t s_NoSlot{ std::numeric_limits<uint32_t>::max() };
+	static constexpr uint32_t s_FreeType{ std::numeric_limits<uint32_t>::max() };
+
+	std::tuple<DenseArray<Types>...> m_Arrays;
+	std::vector<Slot> m_Slots;
+	uint32_t m_FreeSlot{ s_NoSlot };
+	uint64_t m_CreationCounter{ 0U };
+
+	[[nodiscard]] static constexpr ID MakeID(const uint32_t slotIndex, const uint32_t generation) noexcept
+	{
+		return (static_cast<ID>(generation) << 32U) | slotIndex;
+	}
+
+	template<typename Type>
+	[[nodiscard]] static constexpr uint32_t IndexOf() noexcept
+	{
+		uint32_t index{ 0U };
+		(void)((std::is_same_v<Type, Types> ? false : (++index, true)) && ...);
+		return index;
+	}
+
+	template<size_t TypeIndex = 0U, typename Arrays, typename Visitor>
+	static decltype(auto) VisitValue(Arrays& arrays, const Slot& slot, Visitor& visitor)
+	{
+		if constexpr (TypeIndex + 1U < sizeof...(Types))
+		{
+			if (slot.Type != TypeIndex)
+				return VisitValue<TypeIndex + 1U>(arrays, slot, visitor);
+		}
+
+		return visitor(std::get<TypeIndex>(arrays).Values[slot.Index]);
+	}
+
+	template<typename Array, typename Visitor>
+	void ForEachValue(Array& array, Visitor& visitor) const
+	{
+		for (size_t i{ 0U }; i < array.Values.size(); ++i)
+			visitor(MakeID(array.Slots[i], m_Slots[array.Slots[i]].Generation), array.Values[i]);
+	}
+
+	template<size_t TypeIndex = 0U>
+	void EraseValue(const Slot& slot) noexcept
+	{
+		if constexpr (TypeIndex + 1U < sizeof...(Types))
+		{
+			if (slot.Type != TypeIndex)
+				return EraseValue<TypeIndex + 1U>(slot);
+		}
+
+		auto& array{ std::get<TypeIndex>(m_Arrays) };
+		const uint32_t lastIndex{ static_cast<uint32_t>(array.Values.size() - 1U) };
+		if (slot.Index != lastIndex)
+		{
+			array.Values[slot.Index] = std::move(array.Values[lastIndex]);
+			array.Slots[slot.Index] = array.Slots[lastIndex];
+			m_Slots[array.Slots[slot.Index]].Index = slot.Index;
+		}
+
+		array.Values.pop_back();
+		array.Slots.pop_back();
+	}
+};
\ No newline at end of file
@@ -16,10 +16,12 @@ public:
 private:
 	void OpenProject(const std::filesystem::path& path);
 	void SaveAs(const std::filesystem::path& path);
+	void RecoverAutosave(const std::filesystem::path& autosavePath);
 	void SetWindowAppendix(const std::string& appendix);
 private:
 	std::vector<PanelBase*> m_Panels;
 	std::filesystem::path m_CurrentProjectDirectory;
+	std::filesystem::path m_CurrentProjectPath;
 
 	static constexpr std::string_view VanillaWindowName{ "Visualizer" };
 	static constexpr std::string_view VisualizerProjectFilter{ "Visualizer Project (*.vis)\0*.vis\0" };
@@ -32,5 +34,11 @@ private:
 		"(*.frn)\0*.frn\0" 
 		"(*.fa)\0*.fa\0" 
 		"(*.txt)\0*.txt\0"
+		"(*.gz)\0*.gz\0"
 	};
+	static constexpr std::string_view ProteinFastaFilter{ "Protein FASTA file (*.faa)\0*.faa\0" };
+	static constexpr std::string_view PropertyTableFilter{ "Tab separated values (*.tsv)\0*.tsv\0" };
+	static constexpr std::string_view PropertyJsonFilter{ "JSON Lines (*.jsonl)\0*.jsonl\0" };
+	static constexpr std::string_view HexamerTableFilter{ "Hexamer table (*.tsv)\0*.tsv\0" };
+	static constexpr std::string_view CodonUsageTableFilter{ "Codon usage table (*.txt)\0*.txt\0" };
 };
\ No newline at end of file
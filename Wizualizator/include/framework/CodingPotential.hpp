@@ -0,0 +1,244 @@
+#pragma once
+#include "OpenReadingFrames.hpp"
+#include <cmath>
+#include <cstdlib>
+#include <istream>
+#include <optional>
+
+namespace Bio {
+	struct CodingPotential
+	{
+		float Fickett;					/* TESTCODE, >= 0.95 coding, <= 0.74 non-coding */
+		std::optional<float> Hexamer;	/* Mean in-frame hexamer log-likelihood, only with a loaded table */
+	};
+
+	constexpr float g_FickettCodingThreshold{ 0.95f };
+	constexpr float g_FickettNoncodingThreshold{ 0.74f };
+
+	/* Packs every codon of the frame into its 2-bit index, scores then slice ORF ranges out of it */
+	template<typename NucleotideSequence>
+	std::vector<uint8_t> EncodeCodons(const NucleotideSequence& nucleotideSequence)
+	{
+		const size_t codonCount{ nucleotideSequence.size() / 3U };
+		std::vector<uint8_t> codons(codonCount);
+
+		for (size_t i{ 0U }; i < codonCount; ++i)
+			codons[i] = CodonIndex(nucleotideSequence[i * 3U + 0U], nucleotideSequence[i * 3U + 1U], nucleotideSequence[i * 3U + 2U]);
+
+		return codons;
+	}
+
+	/*
+	* Fickett TESTCODE statistic
+	* Reference: Nucleic Acids Res. 10(17):5303-5318(1982).
+	* Tables are pre-multiplied by their base weights, bases ordered A, C, G, T
+	*/
+	namespace Fickett {
+		constexpr float PositionThresholds[10U]{ 1.9f, 1.8f, 1.7f, 1.6f, 1.5f, 1.4f, 1.3f, 1.2f, 1.1f, 0.0f };
+		constexpr float ContentThresholds[10U]{ 0.33f, 0.31f, 0.29f, 0.27f, 0.25f, 0.23f, 0.21f, 0.17f, 0.0f, 0.0f };
+
+		constexpr std::array<std::array<float, 10U>, 4U> WeightedTable(const float (&table)[4U][10U], const float (&weights)[4U]) noexcept
+		{
+			std::array<std::array<float, 10U>, 4U> result{};
+			for (size_t base{ 0U }; base < 4U; ++base)
+				for (size_t i{ 0U }; i < 10U; ++i)
+					result[base][i] = table[base][i] * weights[base];
+
+			return result;
+		}
+
+		constexpr float PositionProbabilities[4U][10U]
+		{
+			{ 0.94f, 0.68f, 0.84f, 0.93f, 0.58f, 0.68f, 0.45f, 0.34f, 0.20f, 0.22f },
+			{ 0.80f, 0.70f, 0.70f, 0.81f, 0.66f, 0.48f, 0.51f, 0.33f, 0.30f, 0.23f },
+			{ 0.90f, 0.88f, 0.74f, 0.64f, 0.53f, 0.48f, 0.27f, 0.16f, 0.08f, 0.08f },
+			{ 0.97f, 0.97f, 0.91f, 0.68f, 0.69f, 0.44f, 0.54f, 0.20f, 0.09f, 0.09f },
+		};
+
+		constexpr float ContentProbabilities[4U][10U]
+		{
+			{ 0.28f, 0.49f, 0.44f, 0.55f, 0.62f, 0.49f, 0.67f, 0.65f, 0.81f, 0.21f },
+			{ 0.82f, 0.64f, 0.51f, 0.64f, 0.59f, 0.59f, 0.43f, 0.44f, 0.39f, 0.31f },
+			{ 0.40f, 0.54f, 0.47f, 0.64f, 0.64f, 0.73f, 0.41f, 0.41f, 0.33f, 0.29f },
+			{ 0.28f, 0.24f, 0.39f, 0.40f, 0.55f, 0.75f, 0.56f, 0.69f, 0.51f, 0.58f },
+		};
+
+		constexpr auto WeightedPosition{ WeightedTable(PositionProbabilities, { 0.26f, 0.18f, 0.31f, 0.33f }) };
+		constexpr auto WeightedContent{ WeightedTable(ContentProbabilities, { 0.11f, 0.12f, 0.15f, 0.14f }) };
+
+		constexpr float LookUp(const std::array<float, 10U>& weightedProbabilities, const float (&thresholds)[10U], const float value) noexcept
+		{
+			for (size_t i{ 0U }; i < 10U; ++i)
+				if (value >= thresholds[i])
+					return weightedProbabilities[i];
+
+			return 0.0f;
+		}
+	}
+
+	inline float CalculateFickettScore(const uint8_t* const codons, const size_t codonCount) noexcept
+	{
+		if (codonCount == 0U)
+			return 0.0f;
+
+		/* Base counts per codon position */
+		uint32_t phaseCounts[3U][4U]{};
+		for (size_t i{ 0U }; i < codonCount; ++i)
+		{
+			const uint8_t codon{ codons[i] };
+			++phaseCounts[0U][(codon >> 4U) & 0b11U];
+			++phaseCounts[1U][(codon >> 2U) & 0b11U];
+			++phaseCounts[2U][codon & 0b11U];
+		}
+
+		const float baseCount{ static_cast<float>(codonCount * 3U) };
+		float score{ 0.0f };
+
+		for (size_t base{ 0U }; base < 4U; ++base)
+		{
+			const uint32_t first{ phaseCounts[0U][base] }, second{ phaseCounts[1U][base] }, third{ phaseCounts[2U][base] };
+			const float content{ static_cast<float>(first + second + third) / baseCount };
+			const float position{ static_cast<float>(std::max({ first, second, third })) / (static_cast<float>(std::min({ first, second, third })) + 1.0f) };
+
+			score += Fickett::LookUp(Fickett::WeightedContent[base], Fickett::ContentThresholds, content);
+			score += Fickett::LookUp(Fickett::WeightedPosition[base], Fickett::PositionThresholds, position);
+		}
+
+		return score;
+	}
+
+	/*
+	* In-frame hexamer log-likelihood ratios of coding vs. non-coding sequences
+	* Reference: Nucleic Acids Res. 41(6):e74(2013) (CPAT)
+	*/
+	class HexamerTable
+	{
+	public:
+		static constexpr size_t s_HexamerCount{ g_CodonCount * g_CodonCount };
+
+		HexamerTable() noexcept
+		{
+			m_LogRatios.fill(std::numeric_limits<float>::quiet_NaN());
+		}
+
+		~HexamerTable() noexcept = default;
+
+		/* CPAT format, one "hexamer <tab> coding frequency <tab> non-coding frequency" per line */
+		bool Load(std::istream& stream)
+		{
+			size_t loadedCount{ 0U };
+			std::string hexamer;
+			double coding{ 0.0 }, noncoding{ 0.0 };
+
+			std::string line;
+			while (std::getline(stream, line))
+			{
+				const size_t firstSeparator{ line.find('\t') };
+				if (firstSeparator != 6U)
+					continue;
+
+				hexamer = line.substr(0U, 6U);
+				const auto index{ HexamerIndex(hexamer) };
+				if (!index.has_value())
+					continue; /* Header */
+
+				const char* const values{ line.c_str() + firstSeparator + 1U };
+				char* end{ nullptr };
+				coding = std::strtod(values, &end);
+				noncoding = std::strtod(end, nullptr);
+
+				float& logRatio{ m_LogRatios[index.value()] };
+				if (coding > 0.0 && noncoding > 0.0)
+					logRatio = static_cast<float>(std::log(coding / noncoding));
+				else if (coding > 0.0)
+					logRatio = 1.0f;
+				else if (noncoding > 0.0)
+					logRatio = -1.0f;
+				else
+					logRatio = std::numeric_limits<float>::quiet_NaN();
+
+				++loadedCount;
+			}
+
+			return loadedCount > 0U;
+		}
+
+		std::optional<float> Score(const uint8_t* const codons, const size_t codonCount) const noexcept
+		{
+			float sum{ 0.0f };
+			size_t count{ 0U };
+
+			/* Hexamers are read in frame, two neighbouring codons at a time */
+			for (size_t i{ 0U }; i + 1U < codonCount; ++i)
+			{
+				const float logRatio{ m_LogRatios[(static_cast<size_t>(codons[i]) << 6U) | codons[i + 1U]] };
+				if (std::isnan(logRatio))
+					continue;
+
+				sum += logRatio;
+				++count;
+			}
+
+			if (count == 0U)
+				return std::nullopt;
+
+			return sum / static_cast<float>(count);
+		}
+	private:
+		static std::optional<size_t> HexamerIndex(const std::string_view hexamer) noexcept
+		{
+			size_t index{ 0U };
+			for (const char character : hexamer)
+			{
+				size_t state{ 0U };
+				switch (ToLower(character))
+				{
+					case 'a': state = 0U; break;
+					case 'c': state = 1U; break;
+					case 'g': state = 2U; break;
+					case 't': case 'u': state = 3U; break;
+
+					default:
+						return std::nullopt;
+				}
+
+				index = (index << 2U) | state;
+			}
+
+			return index;
+		}
+	private:
+		std::array<float, s_HexamerCount> m_LogRatios;
+	};
+
+	/* Scores every ORF of a frame, codons are encoded once and shared by all ranges */
+	template<typename NucleotideSequence>
+	std::vector<CodingPotential> CalculateCodingPotentials(
+		const NucleotideSequence& nucleotideSequence,
+		const std::vector<OpenReadingFrame>& openReadingFrames,
+		const HexamerTable* const hexamerTable = nullptr)
+	{
+		std::vector<CodingPotential> codingPotentials;
+		codingPotentials.reserve(openReadingFrames.size());
+
+		if (openReadingFrames.empty())
+			return codingPotentials;
+
+		const std::vector<uint8_t> codons{ EncodeCodons(nucleotideSequence) };
+		for (const OpenReadingFrame& openReadingFrame : openReadingFrames)
+		{
+			assert(openReadingFrame.End <= codons.size());
+
+			const uint8_t* const begin{ codons.data() + openReadingFrame.Begin };
+			const size_t codonCount{ static_cast<size_t>(openReadingFrame.End - openReadingFrame.Begin) };
+
+			codingPotentials.push_back
+			({
+				.Fickett{ CalculateFickettScore(begin, codonCount) },
+				.Hexamer{ hexamerTable ? hexamerTable->Score(begin, codonCount) : std::nullopt }
+			});
+		}
+
+		return codingPotentials;
+	}
+}
\ No newline at end of file
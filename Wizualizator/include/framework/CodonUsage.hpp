@@ -0,0 +1,237 @@
+#pragma once
+#include "Nucleotides.hpp"
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <istream>
+#include <optional>
+
+namespace Bio {
+	/*
+	* Codons are packed into 6 bits using the 2-bit nucleotide states (A, C, G, T/U)
+	* first * 16 + second * 4 + third
+	*/
+	constexpr size_t g_CodonCount{ 64U };
+
+	template<typename Nucleotide> requires (Nucleotide::s_AlphabetSize == 4U)
+	constexpr uint8_t CodonIndex(const Nucleotide first, const Nucleotide second, const Nucleotide third) noexcept
+	{
+		return static_cast<uint8_t>((first.AsState() << 4U) | (second.AsState() << 2U) | third.AsState());
+	}
+
+	/* 64-bin codon histogram, histograms of separate ranges (or threads) are merged by addition */
+	struct CodonUsage
+	{
+		std::array<uint32_t, g_CodonCount> Counts{};
+
+		constexpr uint32_t& operator[](const uint8_t codonIndex) noexcept
+		{
+			return Counts[codonIndex];
+		}
+
+		constexpr uint32_t operator[](const uint8_t codonIndex) const noexcept
+		{
+			return Counts[codonIndex];
+		}
+
+		constexpr CodonUsage& operator+=(const CodonUsage& other) noexcept
+		{
+			for (size_t i{ 0U }; i < g_CodonCount; ++i)
+				Counts[i] += other.Counts[i];
+
+			return *this;
+		}
+
+		friend constexpr CodonUsage operator+(CodonUsage lhs, const CodonUsage& rhs) noexcept
+		{
+			return lhs += rhs;
+		}
+
+		/* Histogram of a range from running counts taken at its end and at its beginning */
+		constexpr CodonUsage& operator-=(const CodonUsage& other) noexcept
+		{
+			for (size_t i{ 0U }; i < g_CodonCount; ++i)
+				Counts[i] -= other.Counts[i];
+
+			return *this;
+		}
+
+		friend constexpr CodonUsage operator-(CodonUsage lhs, const CodonUsage& rhs) noexcept
+		{
+			return lhs -= rhs;
+		}
+
+		constexpr uint64_t Total() const noexcept
+		{
+			uint64_t total{ 0U };
+			for (const uint32_t count : Counts)
+				total += count;
+
+			return total;
+		}
+	};
+
+	/* Histogram of the codons [beginCodon, endCodon) of a frame */
+	template<typename NucleotideSequence>
+	CodonUsage CountCodonUsage(const NucleotideSequence& nucleotideSequence, const size_t beginCodon, const size_t endCodon) noexcept
+	{
+		assert(beginCodon <= endCodon && endCodon <= nucleotideSequence.size() / 3U);
+
+		CodonUsage codonUsage;
+		for (size_t i{ beginCodon }; i < endCodon; ++i)
+			++codonUsage[CodonIndex(nucleotideSequence[i * 3U + 0U], nucleotideSequence[i * 3U + 1U], nucleotideSequence[i * 3U + 2U])];
+
+		return codonUsage;
+	}
+
+	/* Standard genetic code indexed by codon index */
+	inline const std::array<AminoAcid, g_CodonCount>& CodonTranslationTable()
+	{
+		static const std::array<AminoAcid, g_CodonCount> f_TranslationTable
+		{
+			[]()
+			{
+				std::array<AminoAcid, g_CodonCount> returnValue{};
+				for (uint8_t codonIndex{ 0U }; codonIndex < g_CodonCount; ++codonIndex)
+				{
+					returnValue[codonIndex] = TranslateTriplet
+					(
+						Rna{}.AssignState((codonIndex >> 4U) & 0b11U),
+						Rna{}.AssignState((codonIndex >> 2U) & 0b11U),
+						Rna{}.AssignState(codonIndex & 0b11U)
+					);
+				}
+
+				return returnValue;
+			}()
+		};
+
+		return f_TranslationTable;
+	}
+
+	/*
+	* Codon Adaptation Index
+	* Reference: Nucleic Acids Res. 15(3):1281-1295(1987).
+	* Weights are relative adaptiveness of a codon against its most used synonym in the reference set
+	*/
+	class CodonAdaptationTable
+	{
+	public:
+		CodonAdaptationTable() noexcept
+		{
+			m_LogWeights.fill(std::numeric_limits<float>::quiet_NaN());
+		}
+
+		explicit CodonAdaptationTable(const CodonUsage& reference)
+			:
+			CodonAdaptationTable()
+		{
+			std::array<double, g_CodonCount> frequencies{};
+			for (size_t i{ 0U }; i < g_CodonCount; ++i)
+				frequencies[i] = static_cast<double>(reference.Counts[i]);
+
+			Build(frequencies);
+		}
+
+		~CodonAdaptationTable() noexcept = default;
+
+		/* One "codon <whitespace> count (or frequency)" per line, T and U are interchangeable */
+		bool Load(std::istream& stream)
+		{
+			std::array<double, g_CodonCount> frequencies{};
+			size_t loadedCount{ 0U };
+
+			std::string line;
+			while (std::getline(stream, line))
+			{
+				if (line.size() < 5U)
+					continue;
+
+				const auto index{ ParseCodon(std::string_view{ line }.substr(0U, 3U)) };
+				if (!index.has_value() || !std::isspace(static_cast<unsigned char>(line[3U])))
+					continue; /* Header or comment */
+
+				frequencies[index.value()] = std::strtod(line.c_str() + 3U, nullptr);
+				++loadedCount;
+			}
+
+			if (loadedCount == 0U)
+				return false;
+
+			Build(frequencies);
+			return true;
+		}
+
+		/* Geometric mean of the weights, codons without a weight (Met, Trp, stops, unknown) are skipped */
+		std::optional<float> Calculate(const CodonUsage& codonUsage) const noexcept
+		{
+			double sum{ 0.0 };
+			uint64_t count{ 0U };
+
+			for (size_t i{ 0U }; i < g_CodonCount; ++i)
+			{
+				if (codonUsage.Counts[i] == 0U || std::isnan(m_LogWeights[i]))
+					continue;
+
+				sum += static_cast<double>(codonUsage.Counts[i]) * m_LogWeights[i];
+				count += codonUsage.Counts[i];
+			}
+
+			if (count == 0U)
+				return std::nullopt;
+
+			return static_cast<float>(std::exp(sum / static_cast<double>(count)));
+		}
+	private:
+		void Build(const std::array<double, g_CodonCount>& frequencies) noexcept
+		{
+			const auto& translationTable{ CodonTranslationTable() };
+
+			std::array<double, AminoAcid::s_AlphabetSize> synonymousMaximum{};
+			for (size_t i{ 0U }; i < g_CodonCount; ++i)
+			{
+				double& maximum{ synonymousMaximum[translationTable[i].AsState()] };
+				maximum = std::max(maximum, frequencies[i]);
+			}
+
+			for (size_t i{ 0U }; i < g_CodonCount; ++i)
+			{
+				const AminoAcid amino{ translationTable[i] };
+				const double maximum{ synonymousMaximum[amino.AsState()] };
+
+				/* Single codon families carry no information */
+				if (amino == EAminoAcid::M || amino == EAminoAcid::W || amino == EAminoAcid::STOP || maximum <= 0.0)
+					m_LogWeights[i] = std::numeric_limits<float>::quiet_NaN();
+				else /* Unseen codons get a small floor weight instead of zeroing the whole index */
+					m_LogWeights[i] = static_cast<float>(std::log(frequencies[i] > 0.0 ? frequencies[i] / maximum : s_UnseenCodonWeight));
+			}
+		}
+
+		static std::optional<uint8_t> ParseCodon(const std::string_view codon) noexcept
+		{
+			uint8_t index{ 0U };
+			for (const char character : codon)
+			{
+				uint8_t state{ 0U };
+				switch (ToLower(character))
+				{
+					case 'a': state = 0U; break;
+					case 'c': state = 1U; break;
+					case 'g': state = 2U; break;
+					case 't': case 'u': state = 3U; break;
+
+					default:
+						return std::nullopt;
+				}
+
+				index = static_cast<uint8_t>((index << 2U) | state);
+			}
+
+			return index;
+		}
+	private:
+		static constexpr double s_UnseenCodonWeight{ 0.01 };
+
+		std::array<float, g_CodonCount> m_LogWeights;
+	};
+}
\ No newline at end of file
@@ -77,6 +77,118 @@ namespace Bio {
 		return result;
 	}
 
+	/*
+	* Text straight into states in a single pass, no X sequence in between
+	* Characters outside the alphabet (line breaks included) are skipped, raw multi-line records can be passed as they are
+	*/
+	template<typename Alphabet, typename AlphabetX>
+	constexpr std::vector<Alphabet> EncodeSkippingInvalid(const std::string_view text)
+	{
+		std::vector<Alphabet> result;
+		result.reserve(text.size());
+
+		for (const char character : text)
+		{
+			[[likely]]
+			if (AlphabetX{}.AssignCharacter(character).AsCharacter() != AlphabetX::Invalid)
+				result.emplace_back(Alphabet{}.AssignCharacter(character));
+		}
+
+		return result;
+	}
+
+	constexpr DnaSequence EncodeDNA(const std::string_view text)
+	{
+		return EncodeSkippingInvalid<Dna, DnaX>(text);
+	}
+
+	/* Reverse complement, encoded front to back and then flipped in place */
+	constexpr DnaSequence EncodeDNAReversed(const std::string_view text)
+	{
+		DnaSequence result{ EncodeDNA(text) };
+		std::reverse(result.begin(), result.end());
+
+		for (Dna& nucleotide : result)
+			nucleotide = nucleotide.Complement();
+
+		return result;
+	}
+
+	constexpr RnaSequence EncodeRNA(const std::string_view text)
+	{
+		return EncodeSkippingInvalid<Rna, RnaX>(text);
+	}
+
+	constexpr AminoSequence EncodeAminoSequence(const std::string_view text)
+	{
+		return EncodeSkippingInvalid<AminoAcid, AminoAcidX>(text);
+	}
+
+	/* Four nucleotides per byte, the first one in the lowest two bits */
+	template<typename Nucleotide>
+	constexpr std::vector<uint8_t> PackNucleotides(const std::vector<Nucleotide>& sequence)
+	{
+		static_assert(Nucleotide::s_AlphabetSize == 4U, "Only alphabets of four states fit in two bits");
+
+		std::vector<uint8_t> packed((sequence.size() + 3U) / 4U, 0U);
+		for (size_t i{ 0U }; i < sequence.size(); ++i)
+			packed[i / 4U] |= static_cast<uint8_t>(sequence[i].AsState() << (i % 4U * 2U));
+
+		return packed;
+	}
+
+	template<typename Nucleotide>
+	constexpr std::vector<Nucleotide> UnpackNucleotides(const uint8_t* const packed, const size_t count)
+	{
+		static_assert(Nucleotide::s_AlphabetSize == 4U, "Only alphabets of four states fit in two bits");
+
+		std::vector<Nucleotide> sequence(count);
+		for (size_t i{ 0U }; i < count; ++i)
+			sequence[i].AssignState(static_cast<uint8_t>((packed[i / 4U] >> (i % 4U * 2U)) & 0b11U));
+
+		return sequence;
+	}
+
+	/* 64-bit content hash of one getByte byte per element, eight of them are folded into a little endian word and mixed with the splitmix64 finalizer (seeded with the element count) */
+	template<typename Sequence, typename GetByte>
+	constexpr uint64_t HashBytes(const Sequence& sequence, const GetByte& getByte) noexcept
+	{
+		const auto mix
+		{
+			[](uint64_t value)
+			{
+				value = (value ^ (value >> 30U)) * 0xBF58476D1CE4E5B9ULL;
+				value = (value ^ (value >> 27U)) * 0x94D049BB133111EBULL;
+				return value ^ (value >> 31U);
+			}
+		};
+
+		uint64_t hash{ mix(0x9E3779B97F4A7C15ULL + sequence.size()) };
+		for (size_t wordBegin{ 0U }; wordBegin < sequence.size(); wordBegin += 8U)
+		{
+			uint64_t word{ 0U };
+			for (size_t i{ wordBegin }; i < std::min(wordBegin + 8U, sequence.size()); ++i)
+				word |= static_cast<uint64_t>(getByte(sequence[i])) << ((i - wordBegin) * 8U);
+
+			hash = mix(hash ^ word);
+		}
+
+		return hash;
+	}
+
+	/* Hash of the unpacked states, one AsState() byte per nucleotide (not the 2-bit packing of project files), caches are keyed by it */
+	template<typename Alphabet>
+	constexpr uint64_t HashSequence(const std::vector<Alphabet>& sequence) noexcept
+	{
+		return HashBytes(sequence, [](const Alphabet& state) { return state.AsState(); });
+	}
+
+	/* Hash of the characters, amino sequences are kept as text */
+	constexpr uint64_t HashSequence(const std::string_view sequence) noexcept
+	{
+		return HashBytes(sequence, [](const char character) { return static_cast<uint8_t>(character); });
+	}
+
 	template<typename Type>
 	constexpr RnaXSequence ConvertToRNAX(const Type& type)
 	{
@@ -0,0 +1,324 @@
+#pragma once
+#include "CodonUsage.hpp"
+
+namespace Bio {
+	using OpenReadingFrameFlags = uint8_t;
+
+	enum EOpenReadingFrameFlags : OpenReadingFrameFlags
+	{
+		OpenReadingFrameFlags_None				= 0,		/* Outermost frames, AUG start only */
+		OpenReadingFrameFlags_Nested			= 1 << 0,	/* Report every start inside an already open frame */
+		OpenReadingFrameFlags_AlternativeStarts = 1 << 1,	/* Accept GUG and UUG as (prokaryotic) starts */
+	};
+
+	struct OpenReadingFrame
+	{
+		uint32_t Begin;			/* Codon index of the start codon */
+		uint32_t End;			/* Codon index one past the last coding codon (stop is excluded) */
+		bool AlternativeStart;	/* Started on GUG / UUG, which are still read as methionine */
+	};
+
+	/*
+	* Records every start (AUG, GUG, UUG) with the stop that closes it in a single pass
+	* The ORF modes are views selected from these starts (see SelectOpenReadingFrames), changing the mode doesn't need a rescan
+	*/
+	class OpenReadingFrameScanner
+	{
+	private:
+		enum ECodonClass : uint8_t
+		{
+			CodonClass_None				= 0,
+			CodonClass_Start			= 1 << 0,
+			CodonClass_AlternativeStart = 1 << 1,
+			CodonClass_Stop				= 1 << 2,
+		};
+
+		static constexpr std::array<uint8_t, g_CodonCount> CodonClassTable
+		{
+			[]() constexpr
+			{
+				/* A = 0, C = 1, G = 2, U = 3 */
+				std::array<uint8_t, g_CodonCount> returnValue{};
+				returnValue[0b00'11'10] = CodonClass_Start;				/* AUG */
+				returnValue[0b10'11'10] = CodonClass_AlternativeStart;	/* GUG */
+				returnValue[0b11'11'10] = CodonClass_AlternativeStart;	/* UUG */
+				returnValue[0b11'00'00] = CodonClass_Stop;				/* UAA */
+				returnValue[0b11'00'10] = CodonClass_Stop;				/* UAG */
+				returnValue[0b11'10'00] = CodonClass_Stop;				/* UGA */
+				return returnValue;
+			}()
+		};
+	public:
+		OpenReadingFrameScanner() noexcept
+			:
+			m_Position(0U)
+		{}
+
+		~OpenReadingFrameScanner() noexcept = default;
+
+		void Feed(const uint8_t codonIndex) noexcept
+		{
+			assert(codonIndex < g_CodonCount);
+			const uint8_t codonClass{ CodonClassTable[codonIndex] };
+
+			const size_t openCount{ m_OpenStarts.size() };
+			Feed((codonClass & (CodonClass_Start | CodonClass_AlternativeStart)) != 0U, (codonClass & CodonClass_AlternativeStart) != 0U, (codonClass & CodonClass_Stop) != 0U);
+
+			/* Counted after the step, so the start codon belongs to its frame and the stop doesn't */
+			if (m_OpenStarts.size() > openCount)
+				m_OpenCodonUsageSnapshots.emplace_back(m_SequenceCodonUsage);
+
+			++m_SequenceCodonUsage[codonIndex];
+		}
+
+		/* Residue level entry point, used directly by peptide sequences (M / -) */
+		void Feed(const bool isStart, const bool isAlternativeStart, const bool isStop) noexcept
+		{
+			[[unlikely]]
+			if (isStop)
+				Close(m_Position);
+			else if (isStart)
+				m_OpenStarts.push_back({ .Begin{ m_Position }, .End{ m_Position }, .AlternativeStart{ isAlternativeStart } });
+
+			++m_Position;
+		}
+
+		/* Frames still open at the end of the sequence run to its end, starts closed by the same stop share their end */
+		std::vector<OpenReadingFrame>& Finish() noexcept
+		{
+			Close(m_Position);
+			return m_OpenReadingFrames;
+		}
+
+		const std::vector<OpenReadingFrame>& GetOpenReadingFrames() const noexcept
+		{
+			return m_OpenReadingFrames;
+		}
+
+		/* Parallel to the frames, only filled by the codon level entry point */
+		std::vector<CodonUsage>& GetCodonUsages() noexcept
+		{
+			return m_CodonUsages;
+		}
+
+		const CodonUsage& GetSequenceCodonUsage() const noexcept
+		{
+			return m_SequenceCodonUsage;
+		}
+	private:
+		void Close(const uint32_t end) noexcept
+		{
+			/* Starts are pushed in sequence order, so the outermost frame of a stop is emitted first */
+			for (OpenReadingFrame& openStart : m_OpenStarts)
+			{
+				openStart.End = end;
+				m_OpenReadingFrames.emplace_back(openStart);
+			}
+
+			m_OpenStarts.clear();
+
+			for (const CodonUsage& snapshot : m_OpenCodonUsageSnapshots)
+				m_CodonUsages.emplace_back(m_SequenceCodonUsage - snapshot);
+
+			m_OpenCodonUsageSnapshots.clear();
+		}
+	private:
+		uint32_t m_Position;
+
+		std::vector<OpenReadingFrame> m_OpenStarts;
+		std::vector<OpenReadingFrame> m_OpenReadingFrames;
+
+		CodonUsage m_SequenceCodonUsage;						/* Running histogram of the frame */
+		std::vector<CodonUsage> m_OpenCodonUsageSnapshots;	/* Running histogram as each open start was pushed */
+		std::vector<CodonUsage> m_CodonUsages;
+	};
+
+	/* Translates the sequence and feeds every codon to the scanner in the same pass */
+	template<typename NucleotideSequence>
+	AminoSequence TranslateNucleotideSequence(const NucleotideSequence& nucleotideSequence, OpenReadingFrameScanner& scanner)
+	{
+		const size_t codonCount{ nucleotideSequence.size() / 3U };
+		AminoSequence aminoSequence(codonCount);
+
+		for (size_t i{ 0U }; i < codonCount; ++i)
+		{
+			const auto first{ nucleotideSequence[i * 3U + 0U] };
+			const auto second{ nucleotideSequence[i * 3U + 1U] };
+			const auto third{ nucleotideSequence[i * 3U + 2U] };
+
+			aminoSequence[i] = TranslateTriplet(first, second, third);
+			scanner.Feed(CodonIndex(first, second, third));
+		}
+
+		return aminoSequence;
+	}
+
+	/* Peptides only show their M starts, GUG and UUG can't be told from V and L */
+	inline std::vector<OpenReadingFrame> ScanOpenReadingFrameStarts(const AminoSequence& aminoSequence)
+	{
+		OpenReadingFrameScanner scanner;
+		for (const AminoAcid amino : aminoSequence)
+			scanner.Feed(amino == EAminoAcid::M, false, amino == EAminoAcid::STOP);
+
+		return std::move(scanner.Finish());
+	}
+
+	/*
+	* Indices of the scanned starts a mode reports, in the order they were scanned
+	* Alternative starts are only taken with OpenReadingFrameFlags_AlternativeStarts, without OpenReadingFrameFlags_Nested only the first start taken before each stop is kept
+	*/
+	inline std::vector<uint32_t> SelectOpenReadingFrames(const std::vector<OpenReadingFrame>& openReadingFrameStarts, const OpenReadingFrameFlags flags)
+	{
+		const bool isNested{ (flags & OpenReadingFrameFlags_Nested) != 0U };
+		const bool acceptsAlternative{ (flags & OpenReadingFrameFlags_AlternativeStarts) != 0U };
+
+		std::vector<uint32_t> selection;
+		selection.reserve(openReadingFrameStarts.size());
+		for (uint32_t i{ 0U }; i < openReadingFrameStarts.size(); ++i)
+		{
+			const OpenReadingFrame& openReadingFrameStart{ openReadingFrameStarts[i] };
+			if (openReadingFrameStart.AlternativeStart && !acceptsAlternative)
+				continue;
+
+			/* Starts closed by the same stop share their end, the first one taken is the outermost */
+			if (!isNested && !selection.empty() && openReadingFrameStarts[selection.back()].End == openReadingFrameStart.End)
+				continue;
+
+			selection.push_back(i);
+		}
+
+		return selection;
+	}
+
+	/* Selected elements of anything kept parallel to the scanned starts (frames, codon usages) */
+	template<typename Type>
+	std::vector<Type> GatherSelection(const std::vector<Type>& values, const std::vector<uint32_t>& selection)
+	{
+		std::vector<Type> selected;
+		selected.reserve(selection.size());
+		for (const uint32_t index : selection)
+			selected.emplace_back(values[index]);
+
+		return selected;
+	}
+
+	/* Histograms of many frames in one pass, each one is the running histogram at its end minus the one at its beginning */
+	template<typename NucleotideSequence>
+	std::vector<CodonUsage> CountCodonUsages(const NucleotideSequence& nucleotideSequence, const std::vector<OpenReadingFrame>& openReadingFrames)
+	{
+		/* Codon index, frame index * 2 + is end, a frame's beginning sorts before its end even when it's empty */
+		std::vector<std::pair<uint32_t, size_t>> boundaries;
+		boundaries.reserve(openReadingFrames.size() * 2U);
+		for (size_t i{ 0U }; i < openReadingFrames.size(); ++i)
+		{
+			assert(openReadingFrames[i].Begin <= openReadingFrames[i].End && openReadingFrames[i].End <= nucleotideSequence.size() / 3U);
+
+			boundaries.emplace_back(openReadingFrames[i].Begin, i * 2U);
+			boundaries.emplace_back(openReadingFrames[i].End, i * 2U + 1U);
+		}
+
+		std::sort(boundaries.begin(), boundaries.end());
+
+		std::vector<CodonUsage> codonUsages(openReadingFrames.size());
+		CodonUsage runningCodonUsage;
+		size_t codon{ 0U };
+		for (const auto& [position, boundary] : boundaries)
+		{
+			for (; codon < position; ++codon)
+				++runningCodonUsage[CodonIndex(nucleotideSequence[codon * 3U + 0U], nucleotideSequence[codon * 3U + 1U], nucleotideSequence[codon * 3U + 2U])];
+
+			CodonUsage& codonUsage{ codonUsages[boundary / 2U] };
+			codonUsage = (boundary % 2U == 0U) ? runningCodonUsage : runningCodonUsage - codonUsage;
+		}
+
+		return codonUsages;
+	}
+
+	inline std::vector<AminoSequence> ExtractProteinCandidates(const AminoSequence& aminoSequence, const std::vector<OpenReadingFrame>& openReadingFrames)
+	{
+		std::vector<AminoSequence> proteinCandidates;
+		proteinCandidates.reserve(openReadingFrames.size());
+
+		for (const OpenReadingFrame& openReadingFrame : openReadingFrames)
+		{
+			assert(openReadingFrame.Begin < openReadingFrame.End && openReadingFrame.End <= aminoSequence.size());
+
+			AminoSequence& candidate
+			{
+				proteinCandidates.emplace_back
+				(
+					aminoSequence.begin() + openReadingFrame.Begin,
+					aminoSequence.begin() + openReadingFrame.End
+				)
+			};
+
+			/* Initiator tRNA reads alternative starts as methionine */
+			if (openReadingFrame.AlternativeStart)
+				candidate.front() = AminoAcid{}.AssignCharacter('M');
+		}
+
+		return proteinCandidates;
+	}
+
+	/*
+	* Recovers codon ranges of candidates stored without them (e.g. text projects)
+	* Candidates are expected in the order they were extracted, a leading M is looked for as it is first
+	* Only when no M matches it may stand for an alternative start, which translates to V (GUG) or L (UUG)
+	*/
+	inline std::vector<OpenReadingFrame> LocateOpenReadingFrames(const AminoSequence& aminoSequence, const std::vector<AminoSequence>& proteinCandidates)
+	{
+		std::vector<OpenReadingFrame> openReadingFrames;
+		openReadingFrames.reserve(proteinCandidates.size());
+
+		const size_t sequenceSize{ aminoSequence.size() };
+		size_t searchBegin{ 0U };
+
+		const auto locate
+		{
+			[&aminoSequence, sequenceSize](const AminoSequence& candidate, const size_t searchBegin, const auto& isStart) -> std::optional<size_t>
+			{
+				const size_t candidateSize{ candidate.size() };
+				for (size_t begin{ searchBegin }; begin + candidateSize <= sequenceSize; ++begin)
+				{
+					const size_t end{ begin + candidateSize };
+
+					/* Frames always end on a stop or the end of the sequence, cheapest rejection first */
+					if (end != sequenceSize && aminoSequence[end] != EAminoAcid::STOP)
+						continue;
+
+					if (!isStart(aminoSequence[begin]) || !std::equal(candidate.begin() + 1U, candidate.end(), aminoSequence.begin() + begin + 1U))
+						continue;
+
+					return begin;
+				}
+
+				return std::nullopt;
+			}
+		};
+
+		for (const AminoSequence& candidate : proteinCandidates)
+		{
+			OpenReadingFrame& located{ openReadingFrames.emplace_back(OpenReadingFrame{ .Begin{ 0U }, .End{ 0U }, .AlternativeStart{ false } }) };
+
+			[[unlikely]]
+			if (candidate.empty())
+				continue;
+
+			std::optional<size_t> begin{ locate(candidate, searchBegin, [&candidate](const AminoAcid amino) { return amino == candidate.front(); }) };
+			if (!begin && candidate.front() == EAminoAcid::M)
+			{
+				begin = locate(candidate, searchBegin, [](const AminoAcid amino) { return amino == EAminoAcid::V || amino == EAminoAcid::L; });
+				located.AlternativeStart = begin.has_value();
+			}
+
+			if (!begin)
+				continue;
+
+			located.Begin = static_cast<uint32_t>(begin.value());
+			located.End = static_cast<uint32_t>(begin.value() + candidate.size());
+			searchBegin = begin.value();
+		}
+
+		return openReadingFrames;
+	}
+}
\ No newline at end of file
@@ -3,6 +3,7 @@
 #include <stdint.h>
 #include <string_view>
 #include <vector>
+#include <array>
 
 namespace Bio {
 	/*
@@ -506,6 +507,61 @@ namespace Bio {
 		return netCharge;
 	}
 
+	/* Counts of the ionizable side chains in the order D, E, C, Y, H, K, R */
+	using IonizableCounts = std::array<int64_t, 7U>;
+
+	double CalculateIonizableCharge(const IonizableCounts& counts, const double pH) noexcept
+	{
+		const double cTerminalCharge		{ -1.0 / (1.0 + pow(10, (3.65 - pH))) };
+		const double N2HTerminalCharge		{ 1.0 / (1.0 + pow(10, (pH - 8.2))) };
+		const double asparticAcidCharge		{ -static_cast<double>(counts[0U]) / (1.0 + pow(10, (3.9 - pH))) };
+		const double glutamicAcidCharge		{ -static_cast<double>(counts[1U]) / (1.0 + pow(10, (4.07 - pH))) };
+		const double cysteineCharge			{ -static_cast<double>(counts[2U]) / (1.0 + pow(10, (8.18 - pH))) };
+		const double tyrosineCharge			{ -static_cast<double>(counts[3U]) / (1.0 + pow(10, (10.46 - pH))) };
+		const double histidineCharge		{ static_cast<double>(counts[4U]) / (1.0 + pow(10, (pH - 6.04))) };
+		const double lysineCharge			{ static_cast<double>(counts[5U]) / (1.0 + pow(10, (pH - 10.54))) };
+		const double arginineCharge			{ static_cast<double>(counts[6U]) / (1.0 + pow(10, (pH - 12.48))) };
+
+		return
+			+ cTerminalCharge
+			+ N2HTerminalCharge
+			+ asparticAcidCharge
+			+ glutamicAcidCharge
+			+ cysteineCharge
+			+ tyrosineCharge
+			+ histidineCharge
+			+ lysineCharge
+			+ arginineCharge;
+	}
+
+	/*
+	* First pH of the 0.01 grid at which the charge is no longer positive, 0 when it stays positive up to 14
+	* Every term falls with the pH, so the grid is bisected instead of walked step by step
+	*/
+	double SearchIsoelectricPoint(const IonizableCounts& counts) noexcept
+	{
+		constexpr size_t stepCount{ 1400U };
+
+		size_t first{ 0U };
+		size_t count{ stepCount + 1U };
+		while (count > 0U)
+		{
+			const size_t step{ count / 2U };
+			if (CalculateIonizableCharge(counts, static_cast<double>(first + step) * 0.01) > 0.0)
+			{
+				first += step + 1U;
+				count -= step + 1U;
+			}
+			else
+				count = step;
+		}
+
+		if (first > stepCount)
+			return 0.0; /* Should never happen */
+
+		return static_cast<double>(first) * 0.01;
+	}
+
 	double CalculateIsoelectricPoint(const AminoSequence& sequence) noexcept
 	{
 		if (sequence.empty())
@@ -535,51 +591,7 @@ namespace Bio {
 			}
 		}
 
-		double cTerminalCharge{ 0.0 };
-		double N2HTerminalCharge{ 0.0 };
-		double asparticAcidCharge{ 0.0 };
-		double glutamicAcidCharge{ 0.0 };
-		double cysteineCharge{ 0.0 };
-		double tyrosineCharge{ 0.0 };
-		double histidineCharge{ 0.0 };
-		double lysineCharge{ 0.0 };
-		double arginineCharge{ 0.0 };
-
-		double netCharge{ 0.0 };
-		double pH{ 0.0 };
-		do
-		{
-			cTerminalCharge			= -1					/ (1.0 + pow(10, (3.65 - pH)));
-			N2HTerminalCharge		= 1						/ (1.0 + pow(10, (pH - 8.2)));
-			asparticAcidCharge		= -asparigineCount		/ (1.0 + pow(10, (3.9 - pH)));
-			glutamicAcidCharge		= -glutamicAcidCount	/ (1.0 + pow(10, (4.07 - pH)));
-			cysteineCharge			= -cysteineCount		/ (1.0 + pow(10, (8.18 - pH)));
-			tyrosineCharge			= -tyrosineCount		/ (1.0 + pow(10, (10.46 - pH)));
-			histidineCharge			= histidineCount		/ (1.0 + pow(10, (pH - 6.04)));
-			lysineCharge			= lysineCount			/ (1.0 + pow(10, (pH - 10.54)));
-			arginineCharge			= arginineCount			/ (1.0 + pow(10, (pH - 12.48)));
-
-			netCharge =
-				+ cTerminalCharge
-				+ N2HTerminalCharge
-				+ asparticAcidCharge
-				+ glutamicAcidCharge
-				+ cysteineCharge
-				+ tyrosineCharge
-				+ histidineCharge
-				+ lysineCharge
-				+ arginineCharge;
-
-			if (netCharge <= 0)
-				break;
-
-			if (pH >= 14.0)
-				return 0.0; /* Should never happen */
-
-			pH += 0.01;
-		} while (true);
-
-		return pH;
+		return SearchIsoelectricPoint({ asparigineCount, glutamicAcidCount, cysteineCount, tyrosineCount, histidineCount, lysineCount, arginineCount });
 	}
 	
 	double CalculateIsoelectricPoint(const std::string_view protein) noexcept
@@ -611,51 +623,7 @@ namespace Bio {
 			}
 		}
 
-		double cTerminalCharge{ 0.0 };
-		double N2HTerminalCharge{ 0.0 };
-		double asparticAcidCharge{ 0.0 };
-		double glutamicAcidCharge{ 0.0 };
-		double cysteineCharge{ 0.0 };
-		double tyrosineCharge{ 0.0 };
-		double histidineCharge{ 0.0 };
-		double lysineCharge{ 0.0 };
-		double arginineCharge{ 0.0 };
-
-		double netCharge{ 0.0 };
-		double pH{ 0.0 };
-		do
-		{
-			cTerminalCharge		= -1 / (1 + pow(10, (3.65 - pH)));
-			N2HTerminalCharge	= 1 / (1 + pow(10, (pH - 8.2)));
-			asparticAcidCharge	= -asparigineCount / (1 + pow(10, (3.9 - pH)));
-			glutamicAcidCharge	= -glutamicAcidCount / (1 + pow(10, (4.07 - pH)));
-			cysteineCharge		= -cysteineCount / (1 + pow(10, (8.18 - pH)));
-			tyrosineCharge		= -tyrosineCount / (1 + pow(10, (10.46 - pH)));
-			histidineCharge		= histidineCount / (1 + pow(10, (pH - 6.04)));
-			lysineCharge		= lysineCount / (1 + pow(10, (pH - 10.54)));
-			arginineCharge		= arginineCount / (1 + pow(10, (pH - 12.48)));
-
-			netCharge =
-				+cTerminalCharge
-				+ N2HTerminalCharge
-				+ asparticAcidCharge
-				+ glutamicAcidCharge
-				+ cysteineCharge
-				+ tyrosineCharge
-				+ histidineCharge
-				+ lysineCharge
-				+ arginineCharge;
-
-			if (netCharge <= 0)
-				break;
-
-			if (pH >= 14.0)
-				return 0.0; /* Should never happen */
-
-			pH += 0.01;
-		} while (true);
-
-		return pH;
+		return SearchIsoelectricPoint({ asparigineCount, glutamicAcidCount, cysteineCount, tyrosineCount, histidineCount, lysineCount, arginineCount });
 	}
 
 	std::pair<std::vector<double>, std::vector<double>> GenerateIsoelectricPlotData(const std::string_view protein)
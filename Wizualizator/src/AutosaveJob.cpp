@@ -0,0 +1,74 @@
+#include "AutosaveJob.hpp"
+
+AutosaveJob::AutosaveJob(ProjectSnapshot&& snapshot, std::filesystem::path&& path)
+	:
+	m_Worker()
+{
+	m_Worker = std::thread([this, snapshot = std::move(snapshot), path = std::move(path)]()
+	{
+		try
+		{
+			ProjectSerializer::WriteSnapshot(snapshot, path);
+		}
+		catch (...)
+		{
+			HandleExceptions();
+		}
+
+		m_Finished = true;
+	});
+}
+
+AutosaveJob::~AutosaveJob() noexcept
+{
+	if (m_Worker.joinable())
+		m_Worker.join();
+}
+
+void AutosaveJob::Update(const std::filesystem::path& projectPath)
+{
+	if (s_Job && s_Job->m_Finished)
+		s_Job.reset();
+
+	const std::chrono::steady_clock::time_point now{ std::chrono::steady_clock::now() };
+
+	BIO_LIKELY
+	if (s_Job || now - s_LastSaveTime < s_Interval || !Project::IsUnsaved() || Project::GetRevision() == s_SavedRevision)
+		return;
+
+	s_LastSaveTime = now;
+	s_SavedRevision = Project::GetRevision();
+	s_Job = std::make_unique<AutosaveJob>(ProjectSerializer::TakeSnapshot(), GetPath(projectPath));
+}
+
+void AutosaveJob::Wait() noexcept
+{
+	s_Job.reset();
+}
+
+void AutosaveJob::Discard(const std::filesystem::path& projectPath) noexcept
+{
+	Wait();
+
+	try
+	{
+		std::error_code error;
+		std::filesystem::remove(GetPath(projectPath), error);
+	}
+	catch (...)
+	{
+		HandleExceptions();
+	}
+
+	s_SavedRevision = Project::GetRevision();
+	s_LastSaveTime = std::chrono::steady_clock::now();
+}
+
+std::filesystem::path AutosaveJob::GetPath(const std::filesystem::path& projectPath)
+{
+	BIO_UNLIKELY
+	if (projectPath.empty())
+		return std::filesystem::temp_directory_path() / "Visualizer.autosave.vis";
+
+	return projectPath.parent_path() / (projectPath.stem().string() + ".autosave.vis");
+}
\ No newline at end of file
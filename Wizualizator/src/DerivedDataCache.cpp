@@ -0,0 +1,253 @@
+#include "DerivedDataCache.hpp"
+#include "MappedFile.hpp"
+
+/*
+* Sidecar layout (little endian)
+* CacheHeader | CacheEntry[EntryCount] sorted by key | values (doubles) of the entries
+* Bumped version discards older sidecars, it also stands for the genetic code and the residue tables the results came from
+*/
+struct CacheHeader
+{
+	uint32_t Magic;
+	uint32_t Version;
+	uint64_t EntryCount;
+};
+
+struct CacheEntry
+{
+	uint64_t Hash;
+	uint32_t Kind;
+	uint32_t Parameter;
+	uint64_t Offset;	/* From the beginning of the file */
+	uint64_t Count;		/* Of doubles */
+};
+
+static_assert(sizeof(CacheHeader) == 16U && sizeof(CacheEntry) == 32U, "Cache structures can't be padded");
+
+static constexpr uint32_t g_CacheMagic{ 0x43534956U };	/* "VISC" */
+static constexpr uint32_t g_CacheVersion{ 1U };
+
+template<typename Type>
+static Type ReadAt(const std::string_view view, const size_t offset)
+{
+	Type value;
+	std::memcpy(&value, view.data() + offset, sizeof(Type));
+	return value;
+}
+
+void DerivedDataCache::Open(const std::filesystem::path& projectPath) noexcept
+{
+	Close();
+
+	try
+	{
+		const std::filesystem::path path{ GetPath(projectPath) };
+		std::error_code error;
+
+		BIO_UNLIKELY
+		if (!std::filesystem::exists(path, error))
+			return;
+
+		std::shared_ptr<const MappedFile> mappedFile{ std::make_shared<const MappedFile>(path) };
+		const std::string_view view{ mappedFile->GetView() };
+
+		BIO_UNLIKELY
+		if (view.size() < sizeof(CacheHeader))
+			return;
+
+		const CacheHeader header{ ReadAt<CacheHeader>(view, 0U) };
+
+		BIO_UNLIKELY
+		if (header.Magic != g_CacheMagic || header.Version != g_CacheVersion || header.EntryCount > (view.size() - sizeof(CacheHeader)) / sizeof(CacheEntry))
+			return;
+
+		s_MappedFile = std::move(mappedFile);
+		s_MappedPath = path;
+		s_MappedEntryCount = static_cast<size_t>(header.EntryCount);
+	}
+	catch (...)
+	{
+		HandleExceptions();
+	}
+}
+
+void DerivedDataCache::Save(const std::filesystem::path& projectPath, const std::optional<std::vector<uint64_t>>& contentHashes) noexcept
+{
+	try
+	{
+		const std::filesystem::path path{ GetPath(projectPath) };
+		const auto isUsed
+		{
+			[&contentHashes](const uint64_t hash)
+			{
+				return !contentHashes || std::binary_search(contentHashes->begin(), contentHashes->end(), hash);
+			}
+		};
+
+		/* Values of every entry written, results computed in this session take precedence over the mapped ones */
+		std::map<Key, std::string_view> entries;
+		s_StoredEntries.ForEach([&entries, &isUsed](const Key& key, const std::vector<double>& values)
+		{
+			if (isUsed(key.Hash))
+				entries.emplace(key, std::string_view{ reinterpret_cast<const char*>(values.data()), values.size() * sizeof(double) });
+		});
+
+		const std::string_view view{ s_MappedFile ? s_MappedFile->GetView() : std::string_view{} };
+		for (size_t i{ 0U }; i < s_MappedEntryCount; ++i)
+		{
+			const CacheEntry entry{ ReadAt<CacheEntry>(view, sizeof(CacheHeader) + i * sizeof(CacheEntry)) };
+			const Key key{ .Hash{ entry.Hash }, .Kind{ static_cast<EKind>(entry.Kind) }, .Parameter{ entry.Parameter } };
+
+			/* A truncated sidecar loses the entries past its end */
+			BIO_UNLIKELY
+			if (entry.Offset > view.size() || entry.Count > (view.size() - entry.Offset) / sizeof(double))
+				continue;
+
+			if (isUsed(key.Hash))
+				entries.emplace(key, view.substr(static_cast<size_t>(entry.Offset), static_cast<size_t>(entry.Count) * sizeof(double)));
+		}
+
+		/* Nothing new or dropped since the sidecar was opened, the file already holds everything */
+		if (s_StoredEntries.Count() == 0U && s_MappedFile && s_MappedPath == path && entries.size() == s_MappedEntryCount)
+			return;
+
+		BIO_UNLIKELY
+		if (entries.empty() && !s_MappedFile)
+			return;
+
+		uint64_t offset{ sizeof(CacheHeader) + entries.size() * sizeof(CacheEntry) };
+		std::string output;
+		output.reserve(static_cast<size_t>(offset));
+
+		const CacheHeader header{ .Magic{ g_CacheMagic }, .Version{ g_CacheVersion }, .EntryCount{ entries.size() } };
+		output.append(reinterpret_cast<const char*>(&header), sizeof(CacheHeader));
+
+		for (const auto& [key, values] : entries)
+		{
+			const CacheEntry entry
+			{
+				.Hash{ key.Hash },
+				.Kind{ static_cast<uint32_t>(key.Kind) },
+				.Parameter{ key.Parameter },
+				.Offset{ offset },
+				.Count{ values.size() / sizeof(double) }
+			};
+
+			output.append(reinterpret_cast<const char*>(&entry), sizeof(CacheEntry));
+			offset += values.size();
+		}
+
+		for (const auto& [key, values] : entries)
+			output += values;
+
+		/* Everything was copied out of the mapping, a mapped file couldn't be replaced */
+		s_MappedFile.reset();
+		s_MappedPath.clear();
+		s_MappedEntryCount = 0U;
+
+		std::filesystem::path temporaryPath{ path };
+		temporaryPath += ".tmp";
+
+		{
+			std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+
+			BIO_UNLIKELY
+			if (!file.is_open())
+				THROW_EXCEPTION("Failed to open file");
+
+			file.write(output.data(), static_cast<std::streamsize>(output.size()));
+			file.close();
+
+			BIO_UNLIKELY
+			if (file.fail())
+				THROW_EXCEPTION("Failed to write cache file");
+		}
+
+		std::filesystem::rename(temporaryPath, path);
+
+		s_StoredEntries.Clear();
+		Open(projectPath);
+	}
+	catch (...)
+	{
+		HandleExceptions();
+	}
+}
+
+void DerivedDataCache::Close() noexcept
+{
+	s_MappedFile.reset();
+	s_MappedPath.clear();
+	s_MappedEntryCount = 0U;
+	s_StoredEntries.Clear();
+}
+
+std::optional<std::vector<double>> DerivedDataCache::Find(const Key& key)
+{
+	if (const std::vector<double>* const values{ s_StoredEntries.Find(key) })
+		return *values;
+
+	return FindMapped(key);
+}
+
+void DerivedDataCache::Store(const Key& key, std::vector<double>&& values)
+{
+	const size_t size{ sizeof(Key) + values.size() * sizeof(double) };
+	s_StoredEntries.Emplace(key, std::move(values));
+	s_StoredEntries.Resize(key, size);
+}
+
+std::filesystem::path DerivedDataCache::GetPath(const std::filesystem::path& projectPath)
+{
+	return projectPath.parent_path() / (projectPath.stem().string() + ".viscache");
+}
+
+std::optional<std::vector<double>> DerivedDataCache::FindMapped(const Key& key)
+{
+	BIO_UNLIKELY
+	if (!s_MappedFile)
+		return std::nullopt;
+
+	const std::string_view view{ s_MappedFile->GetView() };
+	const auto entryAt
+	{
+		[&view](const size_t index)
+		{
+			return ReadAt<CacheEntry>(view, sizeof(CacheHeader) + index * sizeof(CacheEntry));
+		}
+	};
+
+	/* Binary search over the sorted entries, only the probed ones are faulted in */
+	size_t first{ 0U };
+	size_t count{ s_MappedEntryCount };
+	while (count > 0U)
+	{
+		const size_t step{ count / 2U };
+		const CacheEntry entry{ entryAt(first + step) };
+
+		if (Key{ .Hash{ entry.Hash }, .Kind{ static_cast<EKind>(entry.Kind) }, .Parameter{ entry.Parameter } } < key)
+		{
+			first += step + 1U;
+			count -= step + 1U;
+		}
+		else
+			count = step;
+	}
+
+	BIO_UNLIKELY
+	if (first == s_MappedEntryCount)
+		return std::nullopt;
+
+	const CacheEntry entry{ entryAt(first) };
+	if (entry.Hash != key.Hash || static_cast<EKind>(entry.Kind) != key.Kind || entry.Parameter != key.Parameter)
+		return std::nullopt;
+
+	/* A truncated sidecar is treated as a miss */
+	BIO_UNLIKELY
+	if (entry.Offset > view.size() || entry.Count > (view.size() - entry.Offset) / sizeof(double))
+		return std::nullopt;
+
+	std::vector<double> values(static_cast<size_t>(entry.Count));
+	std::memcpy(values.data(), view.data() + entry.Offset, values.size() * sizeof(double));
+	return values;
+}
\ No newline at end of file
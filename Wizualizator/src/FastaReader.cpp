@@ -1,56 +1,422 @@
 #include "FastaReader.hpp"
 
-FastaReader::FastaReader(const std::filesystem::path& path)
-	:
-	m_File(path)
+/* Below this much data per part the threads cost more than they save */
+static constexpr size_t g_MinimumPartSize{ 1U << 20U };
+
+std::string_view FastaRecord::Contiguous(std::string& buffer) const
+{
+	const std::string_view content{ TrimLineEnd(Content) };
+
+	BIO_LIKELY
+	if (content.find('\n') == std::string_view::npos)
+	{
+		BIO_UNLIKELY
+		if (content.find(' ') != std::string_view::npos)
+			THROW_EXCEPTION("Invalid format - no spaces allowed");
+
+		return content;
+	}
+
+	buffer.clear();
+	buffer.reserve(content.size());
+
+	size_t position{ 0U };
+	while (position < content.size())
+	{
+		size_t lineEnd{ content.find('\n', position) };
+		if (lineEnd == std::string_view::npos)
+			lineEnd = content.size();
+
+		const std::string_view line{ TrimLineEnd(content.substr(position, lineEnd - position)) };
+
+		BIO_UNLIKELY
+		if (line.find(' ') != std::string_view::npos)
+			THROW_EXCEPTION("Invalid format - no spaces allowed");
+
+		buffer.append(line);
+		position = lineEnd + 1U;
+	}
+
+	return buffer;
+}
+
+std::string_view FastaRecord::Residues() const
 {
+	const std::string_view content{ TrimLineEnd(Content) };
+
 	BIO_UNLIKELY
-	if (!m_File.is_open())
-		THROW_EXCEPTION("Failed to open file");
+	if (content.find(' ') != std::string_view::npos)
+		THROW_EXCEPTION("Invalid format - no spaces allowed");
+
+	return content;
 }
 
-FastaReader::~FastaReader() noexcept
+FastaReader::RecordIterator::RecordIterator(const std::string_view file)
+	:
+	m_File(file),
+	m_Lines(file),
+	m_Record{},
+	m_AtEnd(false)
 {
-	BIO_LIKELY
-	if(m_File.is_open())
-		m_File.close();
+	Advance();
 }
 
-std::vector<std::pair<std::string, std::string>> FastaReader::ReadNucleotideSequences() const
+void FastaReader::RecordIterator::Advance()
 {
-	if (!m_File.is_open())
-		THROW_EXCEPTION("File is not valid");
+	std::string_view sequenceName;
+	size_t contentBegin{ m_Lines.GetPosition() }, contentEnd{ contentBegin };
 
-	m_File.seekg(0U, std::ios::beg);
-	std::vector<std::pair<std::string, std::string>> result;
-	std::string currentLine, sequenceName, sequenceContent;
-	while (std::getline(m_File, currentLine))
+	while (!m_Lines.IsAtEnd())
 	{
+		const size_t lineBegin{ m_Lines.GetPosition() };
+		const std::string_view currentLine{ m_Lines.NextLine() };
 		if (currentLine.empty() || currentLine.front() == s_Identifier)
 		{
+			/* The terminating line is left for the next record */
 			if (!sequenceName.empty())
 			{
-				result.push_back({ sequenceName, sequenceContent });
-				sequenceName.clear();
+				m_Lines.Seek(lineBegin);
+				m_Record = { sequenceName, m_File.substr(contentBegin, contentEnd - contentBegin) };
+				return;
 			}
 
 			if (!currentLine.empty())
 				sequenceName = currentLine.substr(1U);
 
-			sequenceContent.clear();
+			contentBegin = contentEnd = m_Lines.GetPosition();
 		}
 		else if (!sequenceName.empty())
+			contentEnd = lineBegin + currentLine.size(); /* Content spans whole lines, stripped in FastaRecord::Contiguous */
+	}
+
+	if (!sequenceName.empty() && contentEnd > contentBegin)
+	{
+		m_Record = { sequenceName, m_File.substr(contentBegin, contentEnd - contentBegin) };
+		return;
+	}
+
+	m_Record = {};
+	m_AtEnd = true;
+}
+
+FastaIndex FastaIndex::Build(const SequenceFile& file)
+{
+	FastaIndex index;
+
+	std::optional<FastaIndexEntry> entry;
+	bool lastLineSeen{ false };		/* A shorter line (or a blank one) may only end the record */
+
+	/* A line cut by the end of the window is read whole after the next chunk */
+	FileWindow window{ file };
+	do
+	{
+		const std::string_view text{ window.GetLines() };
+		LineReader lines{ text };
+		while (!lines.IsAtEnd())
+		{
+			const size_t lineBegin{ lines.GetPosition() };
+			const std::string_view currentLine{ lines.NextLine() };
+
+			if (!currentLine.empty() && currentLine.front() == FastaReader::s_Identifier)
+			{
+				if (entry.has_value())
+					index.Add(std::move(entry.value()));
+
+				const std::string_view header{ currentLine.substr(1U) };
+				entry = FastaIndexEntry
+				{
+					.Name{ std::string{ header.substr(0U, header.find_first_of(" \t")) } },
+					.Length{ 0U },
+					.Offset{ window.GetOffset() + lines.GetPosition() },
+					.LineBases{ 0U },
+					.LineWidth{ 0U }
+				};
+
+				lastLineSeen = false;
+			}
+			else if (currentLine.empty())
+				lastLineSeen = true;
+			else if (entry.has_value())
+			{
+				BIO_UNLIKELY
+				if (lastLineSeen)
+					THROW_EXCEPTION("Invalid format - uneven line lengths, can't index the file");
+
+				if (entry->LineBases == 0U)
+				{
+					entry->LineBases = static_cast<uint32_t>(currentLine.size());
+					entry->LineWidth = static_cast<uint32_t>(std::min(lines.GetPosition(), text.size()) - lineBegin);
+				}
+				else if (currentLine.size() != entry->LineBases)
+				{
+					BIO_UNLIKELY
+					if (currentLine.size() > entry->LineBases)
+						THROW_EXCEPTION("Invalid format - uneven line lengths, can't index the file");
+
+					lastLineSeen = true;
+				}
+
+				entry->Length += currentLine.size();
+			}
+		}
+
+		window.Consume(text.size());
+	} while (window.Extend());
+
+	if (entry.has_value())
+		index.Add(std::move(entry.value()));
+
+	return index;
+}
+
+std::optional<FastaIndex> FastaIndex::Load(const std::filesystem::path& path)
+{
+	std::ifstream input(path);
+
+	BIO_UNLIKELY
+	if (!input.is_open())
+		return std::nullopt;
+
+	FastaIndex index;
+	std::string currentLine;
+	while (std::getline(input, currentLine))
+	{
+		std::istringstream columns(currentLine);
+		FastaIndexEntry entry{};
+
+		BIO_UNLIKELY
+		if (!std::getline(columns, entry.Name, '\t') || !(columns >> entry.Length >> entry.Offset >> entry.LineBases >> entry.LineWidth))
+			return std::nullopt;
+
+		/* Residue offsets divide by the line length, a stale or hand written index is rebuilt instead */
+		BIO_UNLIKELY
+		if ((entry.LineBases == 0U && entry.Length > 0U) || entry.LineWidth < entry.LineBases)
+			return std::nullopt;
+
+		index.Add(std::move(entry));
+	}
+
+	return index;
+}
+
+void FastaIndex::Save(const std::filesystem::path& path) const
+{
+	std::ofstream output(path, std::ios::binary);
+
+	BIO_UNLIKELY
+	if (!output.is_open())
+		THROW_EXCEPTION("Failed to open file");
+
+	for (const FastaIndexEntry& entry : m_Entries)
+		output << entry.Name << '\t' << entry.Length << '\t' << entry.Offset << '\t' << entry.LineBases << '\t' << entry.LineWidth << '\n';
+}
+
+const FastaIndexEntry* FastaIndex::Find(const std::string_view name) const
+{
+	const auto iterator{ m_EntryLookup.find(std::string{ name }) };
+	return iterator != m_EntryLookup.end() ? &m_Entries[iterator->second] : nullptr;
+}
+
+void FastaIndex::Add(FastaIndexEntry&& entry)
+{
+	/* Like samtools, the first of duplicated names wins */
+	m_EntryLookup.try_emplace(entry.Name, m_Entries.size());
+	m_Entries.emplace_back(std::move(entry));
+}
+
+FastaReader::FastaReader(const std::filesystem::path& path)
+	:
+	m_File(path),
+	m_Index(std::nullopt)
+{}
+
+bool FastaReader::HasFastaExtension(const std::filesystem::path& path)
+{
+	return SequenceFile::HasExtension(path, { ".fasta", ".fa", ".fna", ".faa", ".frn", ".txt" });
+}
+
+/* Every part starts on a header line, so each record is parsed by exactly one worker and the file order is kept */
+static std::vector<FastaRecord> ParseRecords(const std::string_view file)
+{
+	const size_t maximumPartCount{ std::max(std::thread::hardware_concurrency(), 1U) * 4U };
+	const size_t partCount{ std::clamp(file.size() / g_MinimumPartSize, size_t{ 1U }, maximumPartCount) };
+
+	std::vector<std::string_view> parts;
+	parts.reserve(partCount);
+
+	size_t partBegin{ 0U };
+	for (size_t i{ 1U }; i < partCount; ++i)
+	{
+		const size_t header{ file.find("\n>", std::max(partBegin, file.size() / partCount * i)) };
+		if (header == std::string_view::npos)
+			break;
+
+		parts.emplace_back(file.substr(partBegin, header + 1U - partBegin));
+		partBegin = header + 1U;
+	}
+
+	parts.emplace_back(file.substr(partBegin));
+
+	std::vector<std::vector<FastaRecord>> partRecords(parts.size());
+	std::transform(std::execution::par, parts.begin(), parts.end(), partRecords.begin(), [](const std::string_view part)
+	{
+		return std::vector<FastaRecord>(FastaReader::RecordIterator{ part }, FastaReader::RecordIterator{});
+	});
+
+	std::vector<FastaRecord> records;
+	records.reserve(std::accumulate(partRecords.begin(), partRecords.end(), size_t{ 0U }, [](const size_t count, const std::vector<FastaRecord>& part) { return count + part.size(); }));
+
+	for (const std::vector<FastaRecord>& part : partRecords)
+		records.insert(records.end(), part.begin(), part.end());
+
+	return records;
+}
+
+void FastaReader::ReadRecords(const std::function<void(std::span<const FastaRecord> records)>& consumer, const std::stop_token& stopToken) const
+{
+	FileWindow window{ m_File };
+	while (!stopToken.stop_requested())
+	{
+		const std::string_view view{ window.GetView() };
+
+		/* A batch ends right before the first header past the batch size, the window grows until it holds one */
+		size_t batchEnd{ std::string_view::npos };
+		if (view.size() > s_BatchSize)
+			if (const size_t header{ view.find("\n>", s_BatchSize - 1U) }; header != std::string_view::npos)
+				batchEnd = header + 1U;
+
+		if (batchEnd == std::string_view::npos)
+		{
+			if (window.Extend())
+				continue;
+
+			/* Whatever is left makes the last batch */
+			batchEnd = view.size();
+		}
+
+		const std::vector<FastaRecord> records{ ParseRecords(view.substr(0U, batchEnd)) };
+		if (!records.empty())
+			consumer(records);
+
+		window.Consume(batchEnd);
+		if (window.IsAtEnd() && window.GetView().empty())
+			break;
+	}
+}
+
+const FastaIndex& FastaReader::GetIndex() const
+{
+	BIO_LIKELY
+	if (m_Index.has_value())
+		return m_Index.value();
+
+	std::filesystem::path indexPath{ m_File.GetPath() };
+	indexPath += ".fai";
+
+	std::error_code errorCode;
+	if (std::filesystem::exists(indexPath, errorCode) && std::filesystem::last_write_time(indexPath, errorCode) >= std::filesystem::last_write_time(m_File.GetPath(), errorCode) && !errorCode)
+		m_Index = FastaIndex::Load(indexPath);
+
+	if (!m_Index.has_value())
+	{
+		m_Index = FastaIndex::Build(m_File);
+
+		/* Read-only locations just rebuild it the next time */
+		try
 		{
-			BIO_UNLIKELY
-			if (currentLine.find(' ') != std::string::npos)
-				THROW_EXCEPTION("Invalid format - no spaces allowed");
-			else
-				sequenceContent += currentLine;
+			m_Index->Save(indexPath);
 		}
+		catch (...)
+		{}
+	}
+
+	return m_Index.value();
+}
+
+std::string_view FastaReader::Fetch(const std::string_view name, const uint64_t begin, uint64_t end, std::string& buffer) const
+{
+	const FastaIndexEntry* const entry{ GetIndex().Find(name) };
+
+	BIO_UNLIKELY
+	if (!entry)
+		THROW_EXCEPTION("Sequence is not present in the file");
+
+	end = std::min(end, entry->Length);
+	if (begin >= end)
+		return {};
+
+	const uint64_t firstByte{ entry->ResidueOffset(begin) };
+	const uint64_t lastByte{ entry->ResidueOffset(end - 1U) };
+
+	/* Regions inside a single line are served straight from the mapping (or the inflated blocks) */
+	const std::string_view bytes{ ReadBytes(firstByte, lastByte + 1U, buffer) };
+	if (bytes.size() == end - begin)
+		return bytes;
+
+	/* Line breaks are squeezed out front to back, so the bytes can already be in the buffer */
+	if (bytes.data() != buffer.data())
+		buffer.assign(bytes);
+
+	size_t written{ 0U };
+	uint64_t residue{ begin };
+	while (residue < end)
+	{
+		const uint64_t lineRemainder{ entry->LineBases - residue % entry->LineBases };
+		const uint64_t taken{ std::min(lineRemainder, end - residue) };
+		const uint64_t source{ entry->ResidueOffset(residue) - firstByte };
+
+		std::copy_n(buffer.begin() + source, taken, buffer.begin() + written);
+		written += taken;
+		residue += taken;
 	}
 
-	if (!sequenceName.empty() && !sequenceContent.empty())
-		result.push_back({ sequenceName, sequenceContent });
+	buffer.resize(written);
+	return buffer;
+}
+
+std::string_view FastaReader::ReadBytes(const uint64_t begin, const uint64_t end, std::string& buffer) const
+{
+	if (const GzipFile* const compressedFile = m_File.GetCompressedFile())
+		return compressedFile->Read(begin, end, buffer);
+
+	const std::string_view file{ m_File.GetMappedView() };
+
+	BIO_UNLIKELY
+	if (begin > end || end > file.size())
+		THROW_EXCEPTION("Index doesn't match the file");
+
+	return file.substr(begin, end - begin);
+}
+
+std::optional<FastaRegion> FastaReader::ParseRegion(const std::string_view region) const
+{
+	const FastaIndex& index{ GetIndex() };
+
+	/* Names may contain ':' themselves */
+	if (const FastaIndexEntry* const entry = index.Find(region))
+		return FastaRegion{ .Name{ entry->Name }, .Begin{ 0U }, .End{ entry->Length } };
+
+	const size_t separator{ region.rfind(':') };
+	if (separator == std::string_view::npos)
+		return std::nullopt;
+
+	const FastaIndexEntry* const entry{ index.Find(region.substr(0U, separator)) };
+	if (!entry)
+		return std::nullopt;
+
+	std::string range{ region.substr(separator + 1U) };
+	range.erase(std::remove(range.begin(), range.end(), ','), range.end());
+
+	char* parsedEnd{ nullptr };
+	const uint64_t first{ std::strtoull(range.c_str(), &parsedEnd, 10) };
+	uint64_t last{ entry->Length };
+
+	if (*parsedEnd == '-')
+		last = std::strtoull(parsedEnd + 1U, &parsedEnd, 10);
+
+	BIO_UNLIKELY
+	if (*parsedEnd != '\0' || first == 0U || last < first)
+		return std::nullopt;
 
-	return result;
+	return FastaRegion{ .Name{ entry->Name }, .Begin{ first - 1U }, .End{ std::min(last, entry->Length) } };
 }
\ No newline at end of file
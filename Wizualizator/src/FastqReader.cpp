@@ -0,0 +1,217 @@
+#include "FastqReader.hpp"
+
+std::optional<FastqRecord> FastqFilter::Apply(const FastqRecord& record) const noexcept
+{
+	size_t length{ record.Quality.size() };
+
+	/* Cuts where the summed (threshold - score) from the 3' end peaks, lone good bases don't stop the trim */
+	if (TrimQuality > 0U)
+	{
+		int32_t sum{ 0 }, maximumSum{ 0 };
+		for (size_t i{ record.Quality.size() }; i-- > 0U;)
+		{
+			sum += static_cast<int32_t>(TrimQuality) - (static_cast<int32_t>(record.Quality[i]) - FastqReader::s_QualityOffset);
+			if (sum < 0)
+				break;
+
+			if (sum > maximumSum)
+			{
+				maximumSum = sum;
+				length = i;
+			}
+		}
+	}
+
+	if (length == 0U || length < MinimumLength)
+		return std::nullopt;
+
+	uint64_t qualitySum{ 0U };
+	for (size_t i{ 0U }; i < length; ++i)
+		qualitySum += static_cast<uint64_t>(record.Quality[i] - FastqReader::s_QualityOffset);
+
+	if (static_cast<float>(qualitySum) / static_cast<float>(length) < MinimumMeanQuality)
+		return std::nullopt;
+
+	return FastqRecord{ .Name{ record.Name }, .Sequence{ record.Sequence.substr(0U, length) }, .Quality{ record.Quality.substr(0U, length) } };
+}
+
+void FastqStatistics::Add(const FastqRecord& record)
+{
+	const size_t length{ record.Quality.size() };
+
+	if (m_PositionHistograms.size() < length)
+		m_PositionHistograms.resize(length);
+
+	if (m_LengthDistribution.size() <= length)
+		m_LengthDistribution.resize(length + 1U);
+
+	uint64_t qualitySum{ 0U };
+	for (size_t i{ 0U }; i < length; ++i)
+	{
+		const uint8_t character{ static_cast<uint8_t>(record.Quality[i]) };
+		const size_t score{ static_cast<size_t>(character - FastqReader::s_QualityOffset) };
+
+		BIO_UNLIKELY
+		if (character < FastqReader::s_QualityOffset || score >= s_QualityCount)
+			THROW_EXCEPTION("Invalid format - quality score out of range");
+
+		++m_PositionHistograms[i][score];
+		qualitySum += score;
+	}
+
+	++m_LengthDistribution[length];
+	if (length > 0U)
+		++m_ReadQualityDistribution[(qualitySum + length / 2U) / length];
+
+	++m_ReadCount;
+	m_BaseCount += length;
+	m_QualitySum += qualitySum;
+}
+
+FastqStatistics& FastqStatistics::operator+=(const FastqStatistics& other)
+{
+	if (m_PositionHistograms.size() < other.m_PositionHistograms.size())
+		m_PositionHistograms.resize(other.m_PositionHistograms.size());
+
+	for (size_t position{ 0U }; position < other.m_PositionHistograms.size(); ++position)
+		for (size_t score{ 0U }; score < s_QualityCount; ++score)
+			m_PositionHistograms[position][score] += other.m_PositionHistograms[position][score];
+
+	if (m_LengthDistribution.size() < other.m_LengthDistribution.size())
+		m_LengthDistribution.resize(other.m_LengthDistribution.size());
+
+	for (size_t length{ 0U }; length < other.m_LengthDistribution.size(); ++length)
+		m_LengthDistribution[length] += other.m_LengthDistribution[length];
+
+	for (size_t score{ 0U }; score < s_QualityCount; ++score)
+		m_ReadQualityDistribution[score] += other.m_ReadQualityDistribution[score];
+
+	m_ReadCount += other.m_ReadCount;
+	m_BaseCount += other.m_BaseCount;
+	m_QualitySum += other.m_QualitySum;
+	return *this;
+}
+
+std::optional<float> FastqStatistics::GetMeanQuality() const noexcept
+{
+	if (m_BaseCount == 0U)
+		return std::nullopt;
+
+	return static_cast<float>(static_cast<double>(m_QualitySum) / static_cast<double>(m_BaseCount));
+}
+
+std::optional<float> FastqStatistics::GetMeanQuality(const size_t position) const noexcept
+{
+	if (position >= m_PositionHistograms.size())
+		return std::nullopt;
+
+	uint64_t count{ 0U }, sum{ 0U };
+	for (size_t score{ 0U }; score < s_QualityCount; ++score)
+	{
+		count += m_PositionHistograms[position][score];
+		sum += m_PositionHistograms[position][score] * score;
+	}
+
+	if (count == 0U)
+		return std::nullopt;
+
+	return static_cast<float>(static_cast<double>(sum) / static_cast<double>(count));
+}
+
+/*
+* Record at the reader, false once only blank lines are left (or, short of the end of the file, the record is cut)
+* A record that isn't parsed leaves the reader in front of it
+*/
+static bool ParseRecord(LineReader& lines, const bool isLastWindow, FastqRecord& outRecord)
+{
+	const size_t recordBegin{ lines.GetPosition() };
+
+	/* Blank lines between records are tolerated */
+	std::string_view header;
+	while (header.empty())
+	{
+		if (lines.IsAtEnd())
+			return false;
+
+		header = lines.NextLine();
+	}
+
+	BIO_UNLIKELY
+	if (header.front() != FastqReader::s_Identifier)
+		THROW_EXCEPTION("Invalid format - FASTQ record doesn't start with '@'");
+
+	std::array<std::string_view, 3U> recordLines;
+	for (std::string_view& line : recordLines)
+	{
+		if (lines.IsAtEnd() && !isLastWindow)
+		{
+			lines.Seek(recordBegin);
+			return false;
+		}
+
+		line = lines.NextLine();
+	}
+
+	const auto& [sequence, separator, quality] { recordLines };
+
+	BIO_UNLIKELY
+	if (separator.empty() || separator.front() != FastqReader::s_Separator)
+		THROW_EXCEPTION("Invalid format - FASTQ record without the '+' line");
+
+	BIO_UNLIKELY
+	if (quality.size() != sequence.size())
+		THROW_EXCEPTION("Invalid format - sequence and quality lengths differ");
+
+	outRecord = { header.substr(1U), sequence, quality };
+	return true;
+}
+
+FastqReader::FastqReader(const std::filesystem::path& path)
+	:
+	m_File(path)
+{}
+
+bool FastqReader::HasFastqExtension(const std::filesystem::path& path)
+{
+	return SequenceFile::HasExtension(path, { ".fastq", ".fq" });
+}
+
+FastqStatistics FastqReader::Scan(const FastqFilter& filter, const std::function<void(std::span<const FastqRecord> records)>& onAccepted, const std::stop_token& stopToken) const
+{
+	FastqStatistics statistics;
+	std::vector<FastqRecord> accepted;
+	accepted.reserve(s_BatchSize);
+
+	/* Reads point into the window, they are all handed over before it moves on */
+	FileWindow window{ m_File };
+	do
+	{
+		const std::string_view text{ window.GetLines() };
+		LineReader lines{ text };
+
+		FastqRecord record;
+		while (!stopToken.stop_requested() && ParseRecord(lines, window.IsAtEnd(), record))
+		{
+			statistics.Add(record);
+
+			if (const std::optional<FastqRecord> trimmed = filter.Apply(record))
+				accepted.emplace_back(trimmed.value());
+
+			if (accepted.size() == s_BatchSize)
+			{
+				onAccepted(accepted);
+				accepted.clear();
+			}
+		}
+
+		if (!accepted.empty())
+		{
+			onAccepted(accepted);
+			accepted.clear();
+		}
+
+		window.Consume(std::min(lines.GetPosition(), text.size()));
+	} while (!stopToken.stop_requested() && window.Extend());
+
+	return statistics;
+}
\ No newline at end of file
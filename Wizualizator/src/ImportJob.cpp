@@ -0,0 +1,124 @@
+#include "ImportJob.hpp"
+
+ImportJob::ImportJob(std::string&& name, Work&& work, std::vector<std::filesystem::path>&& files)
+	:
+	m_Name(std::move(name)),
+	m_Tasks(),
+	m_Files(files.size()),
+	m_Worker()
+{
+	for (size_t i{ 0U }; i < files.size(); ++i)
+		m_Files[i].Path = std::move(files[i]);
+
+	m_Worker = std::thread([this, work = std::move(work)]()
+	{
+		try
+		{
+			work(*this);
+		}
+		catch (...)
+		{
+			HandleExceptions();
+		}
+
+		m_Finished = true;
+	});
+}
+
+ImportJob::~ImportJob() noexcept
+{
+	Cancel();
+
+	if (m_Worker.joinable())
+		m_Worker.join();
+}
+
+void ImportJob::Launch(std::string name, Work&& work, std::vector<std::filesystem::path> files)
+{
+	s_Jobs.emplace_back(std::make_unique<ImportJob>(std::move(name), std::move(work), std::move(files)));
+}
+
+void ImportJob::Update()
+{
+	std::erase_if(s_Jobs, [](const std::unique_ptr<ImportJob>& job)
+	{
+		return job->RunPostedTasks();
+	});
+}
+
+void ImportJob::CancelAll() noexcept
+{
+	for (const std::unique_ptr<ImportJob>& job : s_Jobs)
+		job->Cancel();
+
+	s_Jobs.clear();
+}
+
+void ImportJob::Post(std::function<void()>&& task)
+{
+	const std::lock_guard<std::mutex> lock{ m_TaskMutex };
+	m_Tasks.emplace_back(std::move(task));
+}
+
+void ImportJob::ForEachFile(const FileWork& importFile)
+{
+	std::for_each(std::execution::par, m_Files.begin(), m_Files.end(), [this, &importFile](FileProgress& file)
+	{
+		BIO_UNLIKELY
+		if (IsCancelled())
+		{
+			file.State = EFileState::Cancelled;
+			return;
+		}
+
+		file.State = EFileState::Importing;
+		try
+		{
+			file.Records = importFile(file.Path);
+			file.State = IsCancelled() ? EFileState::Cancelled : EFileState::Imported;
+		}
+		catch (...)
+		{
+			HandleExceptions();
+			file.State = EFileState::Failed;
+		}
+	});
+}
+
+float ImportJob::GetProgress() const noexcept
+{
+	if (!m_Files.empty())
+	{
+		const size_t doneCount
+		{
+			static_cast<size_t>(std::count_if(m_Files.begin(), m_Files.end(), [](const FileProgress& file)
+			{
+				return file.State != EFileState::Queued && file.State != EFileState::Importing;
+			}))
+		};
+
+		return static_cast<float>(doneCount) / static_cast<float>(m_Files.size());
+	}
+
+	const uint64_t totalBytes{ m_TotalBytes };
+	return totalBytes > 0U ? std::min(static_cast<float>(m_ProcessedBytes) / static_cast<float>(totalBytes), 1.0f) : 0.0f;
+}
+
+bool ImportJob::RunPostedTasks()
+{
+	/* Read first, tasks posted before the worker finished are all in the queue by then */
+	const bool wasFinished{ m_Finished };
+
+	std::vector<std::function<void()>> tasks;
+	{
+		const std::lock_guard<std::mutex> lock{ m_TaskMutex };
+		tasks.swap(m_Tasks);
+	}
+
+	/* Results of a cancelled import are not registered anymore */
+	if (!IsCancelled())
+		for (const std::function<void()>& task : tasks)
+			task();
+
+	return wasFinished;
+}
\ No newline at end of file
@@ -4,23 +4,332 @@
 #include "imgui.h"
 #include "imgui_internal.h"
 #include "FastaReader.hpp"
+#include "FastqReader.hpp"
+#include "ImportJob.hpp"
+#include "implot.h"
 
 template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
 template<class... Ts> overloaded(Ts...)->overloaded<Ts...>;
 
 #define AMINO_TO_CODE_BUTTON(amino, code) if (ImGui::Button(amino)) sequenceBuffer += code
 
-void DisplaySequenceImportPopup(const char* popupID, bool& outDisplay, const std::optional<const std::filesystem::path> updateImportPath = std::nullopt)
+/* Posted by FASTQ imports, shown until closed */
+static std::optional<FastqStatistics> s_ReadStatistics;
+
+struct BatchImportSummary
+{
+	struct File
+	{
+		std::string Name;
+		ImportJob::EFileState State;
+		uint64_t Records;
+	};
+
+	std::vector<File> Files;
+	uint64_t Bytes{ 0U };
+};
+
+/* Posted when a batch import finishes, shown until closed */
+static std::optional<BatchImportSummary> s_BatchImportSummary;
+
+static inline size_t RecordBytes(const FastaRecord& record) noexcept
+{
+	return record.Name.size() + record.Content.size();
+}
+
+static inline size_t RecordBytes(const FastqRecord& record) noexcept
+{
+	return record.Name.size() + record.Sequence.size() + record.Quality.size();
+}
+
+/* FASTA and FASTQ records only differ in how the residues are read out, they are encoded straight from the file */
+struct ImportOptions
+{
+	std::string ImportAs;
+	bool Reverse{ false };
+	std::string Region;			/* Single FASTA files only */
+	FastqFilter ReadFilter{};	/* Applied to FASTQ files */
+	FrameSettings Settings{};	/* Taken when the import is launched */
+};
+
+template<typename Record, typename ResidueReader>
+static size_t CreateRecordSequences(ImportJob& job, const ImportOptions& options, const std::span<const Record> records, const ResidueReader& readResidues)
+{
+	const auto measure{ [](const Record& record) { return RecordBytes(record); } };
+	const FrameSettings& settings{ options.Settings };
+
+	if (options.ImportAs == "DNA")
+	{
+		return job.CreateSequences<DnaMetadata>(records, [&settings, reverse = options.Reverse, &readResidues](const Record& record)
+		{
+			return DnaMetadata::Create(std::string{ record.Name }, readResidues(record), settings, reverse);
+		}, measure);
+	}
+	else if (options.ImportAs == "RNA")
+	{
+		return job.CreateSequences<RnaMetadata>(records, [&settings, &readResidues](const Record& record)
+		{
+			return RnaMetadata::Create(std::string{ record.Name }, readResidues(record), settings);
+		}, measure);
+	}
+	else if (options.ImportAs == "Peptide")
+	{
+		return job.CreateSequences<AminoMetadata>(records, [&settings, &readResidues](const Record& record)
+		{
+			return AminoMetadata::Create(std::string{ record.Name }, readResidues(record), settings);
+		}, measure);
+	}
+
+	return 0U;
+}
+
+/* Format is picked by the extension, FASTQ statistics are handed back for the caller to show or merge */
+static uint64_t ImportFile(ImportJob& job, const std::filesystem::path& path, const ImportOptions& options, std::optional<FastqStatistics>& outStatistics)
+{
+	if (FastqReader::HasFastqExtension(path))
+	{
+		/* Statistics are gathered in the same pass that filters and trims the reads */
+		const FastqReader fastqReader(path);
+		job.AddTotalBytes(fastqReader.GetSize());
+
+		uint64_t recordCount{ 0U };
+		outStatistics = fastqReader.Scan(options.ReadFilter, [&job, &options, &recordCount](const std::span<const FastqRecord> records)
+		{
+			recordCount += CreateRecordSequences(job, options, records, [](const FastqRecord& record) { return record.Sequence; });
+		}, job.GetStopToken());
+
+		return recordCount;
+	}
+
+	const FastaReader fastaReader(path);
+
+	/* A region is served through the .fai index without parsing the other records */
+	if (!options.Region.empty())
+	{
+		const std::optional<FastaRegion> parsedRegion{ fastaReader.ParseRegion(options.Region) };
+
+		BIO_UNLIKELY
+		if (!parsedRegion.has_value())
+			THROW_EXCEPTION("Invalid region");
+
+		std::string sequenceBuffer;
+		const FastaRecord regionRecord{ .Name{ options.Region }, .Content{ fastaReader.Fetch(parsedRegion->Name, parsedRegion->Begin, parsedRegion->End, sequenceBuffer) } };
+
+		job.AddTotalBytes(RecordBytes(regionRecord));
+		return CreateRecordSequences(job, options, std::span<const FastaRecord>{ &regionRecord, 1U }, [](const FastaRecord& record) { return record.Content; });
+	}
+
+	job.AddTotalBytes(fastaReader.GetSize());
+
+	/* Sequences of a batch are created before the next one is parsed */
+	uint64_t recordCount{ 0U };
+	fastaReader.ReadRecords([&job, &options, &recordCount](const std::span<const FastaRecord> records)
+	{
+		recordCount += CreateRecordSequences(job, options, records, [](const FastaRecord& record) { return record.Residues(); });
+	}, job.GetStopToken());
+
+	return recordCount;
+}
+
+static void LaunchImport(const std::filesystem::path& path, ImportOptions options)
+{
+	ImportJob::Launch(path.filename().string(), [path, options = std::move(options)](ImportJob& job)
+	{
+		std::optional<FastqStatistics> statistics;
+		ImportFile(job, path, options, statistics);
+
+		if (statistics.has_value())
+		{
+			job.Post([statistics = std::move(statistics)]()
+			{
+				s_ReadStatistics = statistics;
+			});
+		}
+	});
+}
+
+/* One job for all the files, each file is imported as a whole by one of the workers */
+static void LaunchBatchImport(std::vector<std::filesystem::path> paths, ImportOptions options)
+{
+	options.Region.clear();
+
+	const std::string jobName{ std::to_string(paths.size()) + " files" };
+	ImportJob::Launch(jobName, [options = std::move(options)](ImportJob& job)
+	{
+		std::mutex statisticsMutex;
+		std::optional<FastqStatistics> readStatistics;
+
+		job.ForEachFile([&job, &options, &statisticsMutex, &readStatistics](const std::filesystem::path& path) -> uint64_t
+		{
+			std::optional<FastqStatistics> statistics;
+			const uint64_t recordCount{ ImportFile(job, path, options, statistics) };
+
+			if (statistics.has_value())
+			{
+				const std::lock_guard<std::mutex> lock{ statisticsMutex };
+				if (readStatistics.has_value())
+					readStatistics.value() += statistics.value();
+				else
+					readStatistics = std::move(statistics);
+			}
+
+			return recordCount;
+		});
+
+		BatchImportSummary summary{ .Bytes{ job.GetProcessedBytes() } };
+		summary.Files.reserve(job.GetFiles().size());
+		for (const ImportJob::FileProgress& file : job.GetFiles())
+			summary.Files.emplace_back(BatchImportSummary::File{ file.Path.filename().string(), file.State, file.Records });
+
+		job.Post([summary = std::move(summary), readStatistics = std::move(readStatistics)]()
+		{
+			s_BatchImportSummary = summary;
+
+			if (readStatistics.has_value())
+				s_ReadStatistics = readStatistics;
+		});
+	}, std::move(paths));
+}
+
+/* Directories are walked recursively, only files one of the readers recognizes are kept */
+static std::vector<std::filesystem::path> CollectImportFiles(const std::string_view payload)
+{
+	const auto isImportable
+	{
+		[](const std::filesystem::path& path)
+		{
+			return FastaReader::HasFastaExtension(path) || FastqReader::HasFastqExtension(path);
+		}
+	};
+
+	std::vector<std::filesystem::path> files;
+	size_t position{ 0U };
+	while (position < payload.size())
+	{
+		size_t lineEnd{ payload.find('\n', position) };
+		if (lineEnd == std::string_view::npos)
+			lineEnd = payload.size();
+
+		const std::filesystem::path path{ payload.substr(position, lineEnd - position) };
+		position = lineEnd + 1U;
+
+		if (std::filesystem::is_directory(path))
+		{
+			for (const std::filesystem::directory_entry& entry : std::filesystem::recursive_directory_iterator(path))
+				if (entry.is_regular_file() && isImportable(entry.path()))
+					files.emplace_back(entry.path());
+		}
+		else if (std::filesystem::is_regular_file(path) && isImportable(path))
+			files.emplace_back(path);
+	}
+
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+	return files;
+}
+
+static void DisplayBatchImportSummary()
+{
+	BIO_LIKELY
+	if (!s_BatchImportSummary.has_value())
+		return;
+
+	bool isOpen{ true };
+	if (ImGui::Begin("Batch import", &isOpen))
+	{
+		const BatchImportSummary& summary{ s_BatchImportSummary.value() };
+
+		uint64_t recordCount{ 0U };
+		size_t failedCount{ 0U };
+		for (const BatchImportSummary::File& file : summary.Files)
+		{
+			recordCount += file.Records;
+			failedCount += file.State == ImportJob::EFileState::Failed;
+		}
+
+		GUI::Text("Files: " + std::to_string(summary.Files.size()) + ", failed: " + std::to_string(failedCount));
+		GUI::Text("Records: " + std::to_string(recordCount) + ", " + std::to_string(summary.Bytes / 1000U / 1000U) + " MB");
+
+		if (ImGui::BeginTable("##BatchImportFiles", 3, ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable))
+		{
+			ImGui::TableSetupColumn("File");
+			ImGui::TableSetupColumn("Result");
+			ImGui::TableSetupColumn("Records");
+			ImGui::TableHeadersRow();
+
+			for (const BatchImportSummary::File& file : summary.Files)
+			{
+				ImGui::TableNextRow();
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(file.Name.c_str());
+				ImGui::TableNextColumn();
+				ImGui::TextUnformatted(file.State == ImportJob::EFileState::Imported ? "Imported" : file.State == ImportJob::EFileState::Failed ? "Failed" : "Cancelled");
+				ImGui::TableNextColumn();
+				GUI::Text(std::to_string(file.Records));
+			}
+
+			ImGui::EndTable();
+		}
+	}
+
+	ImGui::End();
+
+	if (!isOpen)
+		s_BatchImportSummary.reset();
+}
+
+static void DisplayReadStatistics()
 {
-	static std::filesystem::path f_LocalImportPath;
-	if (updateImportPath.has_value())
-		f_LocalImportPath = updateImportPath.value();
+	BIO_LIKELY
+	if (!s_ReadStatistics.has_value())
+		return;
+
+	bool isOpen{ true };
+	if (ImGui::Begin("Read statistics", &isOpen))
+	{
+		const FastqStatistics& statistics{ s_ReadStatistics.value() };
+
+		std::ostringstream precisionConverter;
+		precisionConverter.precision(3);
+		precisionConverter << statistics.GetMeanQuality().value_or(0.0f);
+
+		GUI::Text("Reads: " + std::to_string(statistics.GetReadCount()) + ", bases: " + std::to_string(statistics.GetBaseCount()));
+		GUI::Text("Mean quality: " + precisionConverter.str());
+
+		const size_t positionCount{ statistics.GetPositionHistograms().size() };
+		std::vector<float> meanQualities(positionCount);
+		for (size_t position{ 0U }; position < positionCount; ++position)
+			meanQualities[position] = statistics.GetMeanQuality(position).value_or(0.0f);
+
+		if (ImPlot::BeginPlot("Quality per position##ReadQuality", { -1.0f, -1.0f }, ImPlotFlags_NoLegend))
+		{
+			ImPlot::SetupAxes("Position", "Mean quality", ImPlotAxisFlags_AutoFit, ImPlotAxisFlags_AutoFit);
+			ImPlot::PlotLine("Mean quality", meanQualities.data(), static_cast<int>(meanQualities.size()));
+			ImPlot::EndPlot();
+		}
+	}
+
+	ImGui::End();
+
+	if (!isOpen)
+		s_ReadStatistics.reset();
+}
+
+void DisplaySequenceImportPopup(const char* popupID, bool& outDisplay, std::optional<std::vector<std::filesystem::path>> updateImportPaths = std::nullopt)
+{
+	static std::vector<std::filesystem::path> f_LocalImportPaths;
+	if (updateImportPaths.has_value())
+		f_LocalImportPaths = std::move(updateImportPaths.value());
+
+	const bool isBatch{ f_LocalImportPaths.size() > 1U };
+	const bool hasFastq{ std::any_of(f_LocalImportPaths.begin(), f_LocalImportPaths.end(), [](const std::filesystem::path& path) { return FastqReader::HasFastqExtension(path); }) };
+	const bool hasFasta{ std::any_of(f_LocalImportPaths.begin(), f_LocalImportPaths.end(), [](const std::filesystem::path& path) { return !FastqReader::HasFastqExtension(path); }) };
 
 	ImGuiViewport* mainViewport{ ImGui::GetMainViewport() };
 	float popupWidth{ mainViewport->Size.x * 0.5f };
 	float popupHeight{ mainViewport->Size.y * 0.35f };
 	popupWidth = std::min(popupWidth, 400.0f);
-	popupHeight = std::min(popupHeight, 190.0f);
+	popupHeight = std::min(popupHeight, 270.0f);
 
 	ImGui::SetNextWindowPos({ mainViewport->Size.x * 0.5f - popupWidth * 0.5f, 190.0f });
 	ImGui::SetNextWindowSize({ popupWidth, popupHeight });
@@ -42,7 +351,12 @@ void DisplaySequenceImportPopup(const char* popupID, bool& outDisplay, const std
 		GUI::TextCentered("Import options");
 		ImGui::NewLine();
 
-		GUI::Text("File: " + f_LocalImportPath.string());
+		if (f_LocalImportPaths.empty())
+			GUI::Text("No FASTA or FASTQ files found");
+		else if (isBatch)
+			GUI::Text("Files: " + std::to_string(f_LocalImportPaths.size()) + " (" + f_LocalImportPaths.front().parent_path().string() + ")");
+		else
+			GUI::Text("File: " + f_LocalImportPaths.front().string());
 		const char* comboOptions[3U]{ "DNA", "RNA", "Peptide" };
 		static size_t comboOptionIndex{ 0U };
 
@@ -71,51 +385,65 @@ void DisplaySequenceImportPopup(const char* popupID, bool& outDisplay, const std
 		ImGui::Checkbox("Reverse (5'3' " ICON_FA_ARROW_RIGHT " 3'5')", &shouldReverse);
 		ImGui::EndDisabled();
 
+		auto& openReadingFrameFlags{ Project::GetCalculationContext().OpenReadingFrames.Flags };
+		unsigned int openReadingFrameFlagsCopy{ openReadingFrameFlags };
+		ImGui::CheckboxFlags("Nested ORFs", &openReadingFrameFlagsCopy, Bio::OpenReadingFrameFlags_Nested);
+
+		ImGui::BeginDisabled(comboOptionIndex == 2U);
+		ImGui::CheckboxFlags("Alternative starts (GUG, UUG)", &openReadingFrameFlagsCopy, Bio::OpenReadingFrameFlags_AlternativeStarts);
+		ImGui::EndDisabled();
+
+		/* The flags apply to the whole project, sequences already imported are reselected from their stored starts */
+		if (static_cast<Bio::OpenReadingFrameFlags>(openReadingFrameFlagsCopy) != openReadingFrameFlags)
+		{
+			openReadingFrameFlags = static_cast<Bio::OpenReadingFrameFlags>(openReadingFrameFlagsCopy);
+			Project::RecalculateProteinCandidates();
+		}
+
+		static std::array<char, 256U> f_ImportRegion{ '\0' };
+		static FastqFilter f_FastqFilter{};
+
+		if (hasFastq)
+		{
+			int trimQuality{ f_FastqFilter.TrimQuality };
+			ImGui::SliderInt("Trim 3' below quality##FastqTrim", &trimQuality, 0, 40);
+			f_FastqFilter.TrimQuality = static_cast<uint8_t>(trimQuality);
+
+			int minimumLength{ static_cast<int>(f_FastqFilter.MinimumLength) };
+			ImGui::InputInt("Minimum length##FastqLength", &minimumLength);
+			f_FastqFilter.MinimumLength = static_cast<uint32_t>(std::max(minimumLength, 0));
+
+			ImGui::SliderFloat("Minimum mean quality##FastqMeanQuality", &f_FastqFilter.MinimumMeanQuality, 0.0f, 40.0f, "%.1f");
+		}
+
+		if (hasFasta && !isBatch)
+			ImGui::InputTextWithHint("Region##ImportRegion", "All records (e.g. chr1:1000-2000)", f_ImportRegion.data(), f_ImportRegion.size() - 1U);
+
+		ImGui::BeginDisabled(f_LocalImportPaths.empty());
 		if (ImGui::Button("Import"))
 		{
-			const std::string_view importAs{ comboOptions[comboOptionIndex] };
-			try
+			BIO_LIKELY
+			if (Project::Get())
 			{
-				FastaReader fastaReader(f_LocalImportPath);
-				auto& project{ Project::Get() };
-
-				if (importAs == "DNA")
+				ImportOptions options
 				{
-					for (const auto [sequenceName, sequence] : fastaReader.ReadNucleotideSequences())
-					{
-						auto& ref{ project->RegisterSequence<DnaMetadata>(sequenceName) };
-						auto value{ DnaMetadata::Create(sequenceName, sequence, shouldReverse) };
-						ref = std::move(value);
-					}
-				}
-				else if (importAs == "RNA")
-				{
-					for (const auto [sequenceName, sequence] : fastaReader.ReadNucleotideSequences())
-					{
-						auto& ref{ project->RegisterSequence<RnaMetadata>(sequenceName) };
-						auto value{ RnaMetadata::Create(sequenceName, sequence) };
-						ref = std::move(value);
-					}
-				}
-				else if (importAs == "Peptide")
-				{
-					for (const auto [sequenceName, sequence] : fastaReader.ReadNucleotideSequences())
-					{
-						auto& ref{ project->RegisterSequence<AminoMetadata>(sequenceName) };
-						auto value{ AminoMetadata::Create(sequenceName, sequence) };
-						ref = std::move(value);
-					}
-				}
-			}
-			catch (...)
-			{
-				HandleExceptions();
+					.ImportAs{ comboOptions[comboOptionIndex] },
+					.Reverse{ shouldReverse },
+					.Region{ hasFasta && !isBatch ? f_ImportRegion.data() : "" },
+					.ReadFilter{ f_FastqFilter },
+					.Settings{ Project::GetFrameSettings() }
+				};
+
+				if (isBatch)
+					LaunchBatchImport(f_LocalImportPaths, std::move(options));
+				else
+					LaunchImport(f_LocalImportPaths.front(), std::move(options));
 			}
 
-
 			outDisplay = false;
 			ImGui::CloseCurrentPopup();
 		}
+		ImGui::EndDisabled();
 
 		ImGui::SameLine();
 		if (ImGui::Button("Cancel"))
@@ -263,21 +591,15 @@ void DisplaySequenceTypeCreationPopup(const char* popupID, bool& display)
 			{
 				if constexpr (std::is_same_v<SequenceType, Bio::DnaSequence>)
 				{
-					auto& ref{ project->RegisterSequence<DnaMetadata>(sequenceName) };
-					auto value{ DnaMetadata::Create(sequenceName, sequenceBuffer, shouldReverse) };
-					ref = std::move(value);
+					project->RegisterSequence(DnaMetadata::Create(sequenceName, sequenceBuffer, Project::GetFrameSettings(), shouldReverse));
 				}
 				else if constexpr (std::is_same_v<SequenceType, Bio::RnaSequence>)
 				{
-					auto& ref{ project->RegisterSequence<RnaMetadata>(sequenceName) };
-					auto value{ RnaMetadata::Create(sequenceName, sequenceBuffer) };
-					ref = std::move(value);	
+					project->RegisterSequence(RnaMetadata::Create(sequenceName, sequenceBuffer, Project::GetFrameSettings()));
 				}
 				else if constexpr (std::is_same_v<SequenceType, Bio::AminoSequence>)
 				{
-					auto& ref{ project->RegisterSequence<AminoMetadata>(sequenceName) };
-					auto value{ AminoMetadata::Create(sequenceName, sequenceBuffer) };
-					ref = std::move(value);
+					project->RegisterSequence(AminoMetadata::Create(sequenceName, sequenceBuffer, Project::GetFrameSettings()));
 				}
 			}
 
@@ -318,7 +640,7 @@ void ContentPanel::OnGUIRender()
 	static bool f_DisplayAminoCreation[g_FrameCount]{ false, false, false };
 
 	static bool f_DisplaySequenceImportPopup[g_FrameCount]{ false, false, false };
-	static std::filesystem::path f_ImportPath;
+	static std::optional<std::vector<std::filesystem::path>> f_ImportPaths;
 
 	constexpr const char* g_FrameIndexWindowNames[g_FrameCount]{ "Frame 1", "Frame 2", "Frame 3", };
 	
@@ -337,29 +659,12 @@ void ContentPanel::OnGUIRender()
 			ImGui::Dummy({ ImGui::GetContentRegionAvail().x, ImGui::GetContentRegionAvail().y + ImGui::GetScrollY() });
 			if (ImGui::BeginDragDropTarget())
 			{
-				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("File"))
+				if (const ImGuiPayload* payload = ImGui::AcceptDragDropPayload("Files"))
 				{
 					try
 					{
-						const std::filesystem::path filepath{ reinterpret_cast<const char*>(payload->Data) };
-
-						if (std::filesystem::exists(filepath))
-						{
-							const size_t fileSize{ std::filesystem::file_size(filepath) };
-							if ((fileSize / 1000U / 1000U) > 100U)
-							{
-								if (Platform::PushConfirmationWindow("Import file", "The file has a size of greater than 100MB and is considered a large file. Importing the file will probably slow down the use of the program significantly. Proceed anyway?"))
-								{
-									f_DisplaySequenceImportPopup[frameIndex] = true;
-									f_ImportPath = filepath;
-								}
-							}
-							else
-							{
-								f_DisplaySequenceImportPopup[frameIndex] = true;
-								f_ImportPath = filepath;
-							}
-						}
+						f_ImportPaths = CollectImportFiles(reinterpret_cast<const char*>(payload->Data));
+						f_DisplaySequenceImportPopup[frameIndex] = true;
 					}
 					catch (...)
 					{
@@ -378,6 +683,12 @@ void ContentPanel::OnGUIRender()
 				return static_cast<char>(std::toupper(static_cast<int>(character)));
 			});
 
+			ImGui::Checkbox("Rank ORFs", &m_RankByCodingPotential);
+			ImGui::SameLine();
+			ImGui::PushItemWidth(-1);
+			ImGui::SliderFloat("##MinimumCodingPotential", &m_MinimumCodingPotential, 0.0f, 1.4f, "TESTCODE >= %.2f");
+			ImGui::PopItemWidth();
+
 			ImGui::PushStyleVar(ImGuiStyleVar_FramePadding, { 0.0f, 2.0f });
 			ImGui::Columns(2, nullptr, false);
 			ImGui::SetColumnWidth(0, 190.0f);
@@ -394,28 +705,23 @@ void ContentPanel::OnGUIRender()
 			ImGui::SetColumnWidth(0, 190.0f);
 			ImGui::Unindent();
 
-			for (const auto& [sequenceUUID, sequenceMetadata] : Project::IterateSequences())
+			Project::ForEachSequence(overloaded
 			{
-				std::visit(overloaded
+				[this, frameIndex](const ID sequenceUUID, const DnaMetadata& dnaMetadata)
 				{
-					[this, sequenceUUID, frameIndex](const DnaMetadata& dnaMetadata)
-					{
-						const auto& candidates{ dnaMetadata.Frames[frameIndex].ProteinCandidates };
-						DrawSequence(sequenceUUID, dnaMetadata.SequenceName, ICON_FA_DNA, "DNA", ICON_FA_LINK, candidates, frameIndex);
-					},
-					[this, sequenceUUID, frameIndex](const RnaMetadata& rnaMetadata)
-					{
-						const auto& candidates{ rnaMetadata.Frames[frameIndex].ProteinCandidates };
-						DrawSequence(sequenceUUID, rnaMetadata.SequenceName, ICON_FA_VIRUSES, "RNA", ICON_FA_LINK, candidates, frameIndex);
-					},
-					[this, sequenceUUID, frameIndex](const AminoMetadata& aminoMetadata)
-					{
-						DrawPeptideSequence(sequenceUUID, aminoMetadata.SequenceName, "\xef\x8c\x9c", "Peptide", ICON_FA_LINK, aminoMetadata.AminoSequence);
-					},
-					[](auto arg) { (void)arg; BIO_ASSERT(false); }
+					const auto& frame{ (*dnaMetadata.Frames)[frameIndex] };
+					DrawSequence(sequenceUUID, dnaMetadata.SequenceName, ICON_FA_DNA, "DNA", ICON_FA_LINK, frame.ProteinCandidates, frame.CodingPotentials, frameIndex);
 				},
-				sequenceMetadata);
-			}
+				[this, frameIndex](const ID sequenceUUID, const RnaMetadata& rnaMetadata)
+				{
+					const auto& frame{ (*rnaMetadata.Frames)[frameIndex] };
+					DrawSequence(sequenceUUID, rnaMetadata.SequenceName, ICON_FA_VIRUSES, "RNA", ICON_FA_LINK, frame.ProteinCandidates, frame.CodingPotentials, frameIndex);
+				},
+				[this](const ID sequenceUUID, const AminoMetadata& aminoMetadata)
+				{
+					DrawPeptideSequence(sequenceUUID, aminoMetadata.SequenceName, "\xef\x8c\x9c", "Peptide", ICON_FA_LINK, aminoMetadata.AminoSequence);
+				}
+			});
 
 			ImGui::PushItemWidth(-1);
 			ImGui::SeparatorEx(ImGuiSeparatorFlags_Horizontal | ImGuiSeparatorFlags_SpanAllColumns);
@@ -474,13 +780,8 @@ void ContentPanel::OnGUIRender()
 			constexpr const char* popupID{ "Import File" };
 			ImGui::OpenPopup(popupID);
 
-			BIO_UNLIKELY
-			if(!f_ImportPath.empty())
-				DisplaySequenceImportPopup(popupID, f_DisplaySequenceImportPopup[frameIndex], f_ImportPath);
-			else
-				DisplaySequenceImportPopup(popupID, f_DisplaySequenceImportPopup[frameIndex]);
-
-			f_ImportPath.clear();
+			DisplaySequenceImportPopup(popupID, f_DisplaySequenceImportPopup[frameIndex], std::move(f_ImportPaths));
+			f_ImportPaths.reset();
 		}
 
 		ImGui::End();
@@ -488,12 +789,14 @@ void ContentPanel::OnGUIRender()
 		{
 			Project::UnregisterSequence(uuid);
 			Project::InvalidateSelectionContext(Project::ESequenceSelectionType::None);
-			Project::ResetCache();
 		}
 
 		m_ToRemove.clear();
 	}
 
+	DisplayReadStatistics();
+	DisplayBatchImportSummary();
+
 	if (ImGui::IsKeyPressed(ImGuiKey_Escape))
 	{
 		if(Project::SelectedPeptide())
@@ -512,6 +815,7 @@ void ContentPanel::DrawSequence(
 	const std::string_view tooltip,
 	const std::string_view sequenceChildrenLabel, 
 	const std::vector<Bio::AminoSequence>& candidates,
+	const std::vector<Bio::CodingPotential>& codingPotentials,
 	const ID frameIndex)
 {
 	const bool isSequenceFrameSelected
@@ -619,12 +923,34 @@ void ContentPanel::DrawSequence(
 			candidatesString.emplace_back(std::move(candidate));
 		}
 
-		for (ID peptideIndex{ 0U }; peptideIndex < candidatesString.size(); ++peptideIndex)
+		/* Display order only, selection keeps the original candidate indices */
+		std::vector<ID> displayOrder(candidatesString.size());
+		std::iota(displayOrder.begin(), displayOrder.end(), ID{ 0U });
+
+		const bool hasCodingPotentials{ codingPotentials.size() == candidates.size() };
+		if (m_RankByCodingPotential && hasCodingPotentials)
+		{
+			std::stable_sort(displayOrder.begin(), displayOrder.end(), [&codingPotentials](const ID lhs, const ID rhs)
+			{
+				const Bio::CodingPotential& left{ codingPotentials[lhs] };
+				const Bio::CodingPotential& right{ codingPotentials[rhs] };
+
+				if (left.Hexamer.has_value() && right.Hexamer.has_value() && left.Hexamer.value() != right.Hexamer.value())
+					return left.Hexamer.value() > right.Hexamer.value();
+
+				return left.Fickett > right.Fickett;
+			});
+		}
+
+		for (const ID peptideIndex : displayOrder)
 		{
 			const auto& candidate{ candidatesString[peptideIndex] };
 			if (!m_SearchFilter.empty() && (candidate.find(m_SearchFilter) == std::string::npos))
 				continue;
 
+			if (hasCodingPotentials && codingPotentials[peptideIndex].Fickett < m_MinimumCodingPotential)
+				continue;
+
 			ImGui::NextColumn();
 			ImGui::PushItemWidth(-1);
 			
@@ -651,6 +977,19 @@ void ContentPanel::DrawSequence(
 			if (ImGui::IsItemClicked(ImGuiMouseButton_Left))
 				Project::InvalidateSelectionContext(Project::ESequenceSelectionType::NucleotideSequence, sequenceUUID, frameIndex, peptideIndex);
 
+			BIO_UNLIKELY
+			if (hasCodingPotentials && ImGui::IsItemHovered())
+			{
+				const Bio::CodingPotential& codingPotential{ codingPotentials[peptideIndex] };
+
+				ImGui::BeginTooltip();
+				ImGui::Text("TESTCODE: %.3f", codingPotential.Fickett);
+				if (codingPotential.Hexamer.has_value())
+					ImGui::Text("Hexamer score: %.3f", codingPotential.Hexamer.value());
+
+				ImGui::EndTooltip();
+			}
+
 			ImGui::NextColumn();
 			ImGui::PushItemWidth(-1);
 			ImGui::Text(sequenceChildrenLabel.data());
@@ -4,6 +4,8 @@
 #include "Event.hpp"
 #include "GUI.hpp"
 #include "Platform.hpp"
+#include "FastaReader.hpp"
+#include "FastqReader.hpp"
 
 #include "implot.h"
 #include "imgui_internal.h"
@@ -37,20 +39,26 @@ void ProjectPanel::OnGUIRender()
 	{
 		DrawDirectoryFromRoot(currentWorkingPath, "", [this](const std::filesystem::path& assetPath)
 		{
-			std::string extension{ assetPath.extension().string() };
-			std::transform(extension.begin(), extension.end(), extension.begin(), [](const char character) 
-			{ 
-				return static_cast<char>(std::tolower(character)); 
-			});
+			if (!std::filesystem::is_directory(assetPath) && !FastaReader::HasFastaExtension(assetPath) && !FastqReader::HasFastqExtension(assetPath))
+				return;
 
-			if (extension == ".fasta" || extension == ".txt")
+			if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
 			{
-				if (ImGui::BeginDragDropSource(ImGuiDragDropFlags_SourceAllowNullID))
+				/* Dragging a selected entry takes the whole selection along, directories are expanded by the drop target */
+				std::string payload;
+				if (m_SelectedPaths.contains(assetPath))
 				{
-					const std::string assetPathString{ assetPath.string() };
-					ImGui::SetDragDropPayload("File", assetPathString.c_str(), (assetPathString.size() + 1U) * sizeof(const char));
-					ImGui::EndDragDropSource();
+					for (const std::filesystem::path& selectedPath : m_SelectedPaths)
+						payload += selectedPath.string() + '\n';
+
+					payload.pop_back();
 				}
+				else
+					payload = assetPath.string();
+
+				ImGui::SetDragDropPayload("Files", payload.c_str(), (payload.size() + 1U) * sizeof(const char));
+				GUI::Text(m_SelectedPaths.contains(assetPath) ? std::to_string(m_SelectedPaths.size()) + " entries" : assetPath.filename().string());
+				ImGui::EndDragDropSource();
 			}
 		});
 	}
@@ -162,28 +170,25 @@ void ProjectPanel::DrawDirectoriesRecursively(const std::filesystem::path& direc
 		std::string filenameString = isDirectory ? std::string{ ICON_FA_FOLDER } : std::string{ ICON_FA_FILE };
 		filenameString += " " + filepathEntry.filename().string();
 
+		const ImGuiTreeNodeFlags selectionFlags{ m_SelectedPaths.contains(filepathEntry) ? ImGuiTreeNodeFlags_Selected : ImGuiTreeNodeFlags_None };
+
 		constexpr bool passesFilter = true; // TODO: Add filtering?
 		if (isDirectory)
 		{
 			if (passesFilter)
 			{
-				if (filter.empty())
-				{
-					constexpr ImGuiTreeNodeFlags directoryFlags{ ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnArrow };
-					if (ImGui::TreeNodeEx(filenameString.c_str(), directoryFlags))
-					{
-						DrawDirectoriesRecursively(filepathEntry, "", function);
-						ImGui::TreePop();
-					}
-				}
-				else
+				ImGuiTreeNodeFlags directoryFlags{ ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnArrow | selectionFlags };
+				if (!filter.empty())
+					directoryFlags |= ImGuiTreeNodeFlags_DefaultOpen;
+
+				const bool isOpen{ ImGui::TreeNodeEx(filenameString.c_str(), directoryFlags) };
+				UpdateSelection(filepathEntry);
+				function(filepathEntry);
+
+				if (isOpen)
 				{
-					constexpr ImGuiTreeNodeFlags directoryFlags{ ImGuiTreeNodeFlags_SpanAvailWidth | ImGuiTreeNodeFlags_OpenOnArrow | ImGuiTreeNodeFlags_DefaultOpen };
-					if (ImGui::TreeNodeEx(filenameString.c_str(), directoryFlags))
-					{
-						DrawDirectoriesRecursively(filepathEntry, "", function);
-						ImGui::TreePop();
-					}
+					DrawDirectoriesRecursively(filepathEntry, "", function);
+					ImGui::TreePop();
 				}
 			}
 			else
@@ -198,7 +203,8 @@ void ProjectPanel::DrawDirectoriesRecursively(const std::filesystem::path& direc
 				ImGuiTreeNodeFlags resourceFlags =
 					ImGuiTreeNodeFlags_SpanAvailWidth |
 					ImGuiTreeNodeFlags_OpenOnArrow |
-					ImGuiTreeNodeFlags_Leaf;
+					ImGuiTreeNodeFlags_Leaf |
+					selectionFlags;
 
 				if (!filter.empty())
 					resourceFlags |= ImGuiTreeNodeFlags_Selected;
@@ -206,8 +212,27 @@ void ProjectPanel::DrawDirectoriesRecursively(const std::filesystem::path& direc
 				if (ImGui::TreeNodeEx(filenameString.c_str(), resourceFlags))
 					ImGui::TreePop();
 
+				UpdateSelection(filepathEntry);
 				function(filepathEntry);
 			}
 		}
 	}
+}
+
+void ProjectPanel::UpdateSelection(const std::filesystem::path& path)
+{
+	if (!ImGui::IsItemClicked() || ImGui::IsItemToggledOpen())
+		return;
+
+	/* Ctrl toggles the entry, a plain click selects only it */
+	if (ImGui::GetIO().KeyCtrl)
+	{
+		if (!m_SelectedPaths.erase(path))
+			m_SelectedPaths.insert(path);
+	}
+	else
+	{
+		m_SelectedPaths.clear();
+		m_SelectedPaths.insert(path);
+	}
 }
\ No newline at end of file
@@ -28,8 +28,17 @@ void PropertiesPanel::OnGUIRender()
 	(
 		[this](const Project::NucleotideSequenceCache& nucleotideSequenceCache)
 		{
-			if (ImGui::BeginTable("Properties Table", 2, ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_NoHostExtendY, { 270.0f, 64.0f }))
+			if (ImGui::BeginTable("Properties Table", 2, ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_NoHostExtendY, { 270.0f, 104.0f }))
 			{
+				const auto& codingPotentials{ nucleotideSequenceCache.ProteinCandidateCodingPotentials };
+				const auto likelyCodingCount
+				{
+					std::count_if(codingPotentials.begin(), codingPotentials.end(), [](const Bio::CodingPotential& codingPotential)
+					{
+						return codingPotential.Fickett >= Bio::g_FickettCodingThreshold;
+					})
+				};
+
 				ImGui::TableSetupColumn(nullptr, ImGuiTableColumnFlags_WidthFixed, 150.0f);
 				ImGui::TableNextRow();
 				ImGui::TableSetColumnIndex(0);
@@ -37,17 +46,74 @@ void PropertiesPanel::OnGUIRender()
 				GUI::Text("Sequence Length: ");
 				GUI::Text("Length of amino chain: ");
 				GUI::Text("Number of ORFs: ");
+				GUI::Text("Likely coding ORFs: ");
+				GUI::Text("Codon Adaptation Index: ");
 				
 				ImGui::TableSetColumnIndex(1);
 				GUI::Text(std::to_string(nucleotideSequenceCache.NucleotideSequence.size()));
 				GUI::Text(std::to_string(nucleotideSequenceCache.AminoSequence.size()));
 				GUI::Text(std::to_string(nucleotideSequenceCache.ProteinCandidates.size()));
+				GUI::Text(std::to_string(likelyCodingCount));
+
+				if (nucleotideSequenceCache.CodonAdaptationIndex.has_value())
+				{
+					std::ostringstream precisionConverter;
+					precisionConverter.precision(3);
+					precisionConverter << nucleotideSequenceCache.CodonAdaptationIndex.value();
+					GUI::Text(precisionConverter.str());
+				}
+				else
+					GUI::Text("None");
 				
 				ImGui::EndTable();
 			}
 		},
 		[this](const Project::NucleotideSequencePeptideCache& nucleotideSequencePeptideCache)
 		{
+			BIO_LIKELY
+			if (nucleotideSequencePeptideCache.CodingPotential.has_value())
+			{
+				if (ImGui::BeginTable("Coding Potential Table", 2, ImGuiTableFlags_BordersOuter | ImGuiTableFlags_BordersInnerH | ImGuiTableFlags_NoHostExtendY, { 270.0f, 64.0f }))
+				{
+					const Bio::CodingPotential& codingPotential{ nucleotideSequencePeptideCache.CodingPotential.value() };
+
+					ImGui::TableSetupColumn(nullptr, ImGuiTableColumnFlags_WidthFixed, 117.5f);
+					ImGui::TableNextRow();
+					ImGui::TableSetColumnIndex(0);
+
+					GUI::Text("TESTCODE:");
+					GUI::Text("Hexamer score:");
+					GUI::Text("CAI:");
+
+					ImGui::TableSetColumnIndex(1);
+					std::ostringstream precisionConverter;
+					precisionConverter.precision(3);
+
+					precisionConverter << codingPotential.Fickett;
+					GUI::Text(precisionConverter.str());
+
+					if (codingPotential.Hexamer.has_value())
+					{
+						precisionConverter.str({});
+						precisionConverter << codingPotential.Hexamer.value();
+						GUI::Text(precisionConverter.str());
+					}
+					else
+						GUI::Text("None");
+
+					if (nucleotideSequencePeptideCache.CodonAdaptationIndex.has_value())
+					{
+						precisionConverter.str({});
+						precisionConverter << nucleotideSequencePeptideCache.CodonAdaptationIndex.value();
+						GUI::Text(precisionConverter.str());
+					}
+					else
+						GUI::Text("None");
+
+					ImGui::EndTable();
+				}
+			}
+
 			RenderDesiredSequenceProperties
 			(
 				"H-Sequence-OH",
@@ -118,13 +184,13 @@ void PropertiesPanel::RenderDesiredSequenceProperties(
 		ImGui::Text("PH Level");
 		ImGui::SameLine();
 
-		float netChargePHCopy{ Project::GetCalculationContext().NetCharge.PH };
+		float netChargePHCopy{ Project::GetCalculationContext().NetCharge.PH.Get() };
 		if (ImGui::InputFloat("##phSlider", &netChargePHCopy, 0.0f, 0.0f, "%.1f"))
 		{
 			netChargePHCopy = netChargePHCopy > 14.0f ? 14.0f : netChargePHCopy;
 			netChargePHCopy = netChargePHCopy < 0.1f ? 0.1f : netChargePHCopy;
 
-			Project::GetCalculationContext().NetCharge.PH = netChargePHCopy;
+			Project::GetCalculationContext().NetCharge.PH.Set(netChargePHCopy);
 			Project::RecalculateNetCharge();
 		}
 
@@ -342,13 +408,13 @@ void PropertiesPanel::RenderDesiredSequenceProperties(
 		ImGui::SameLine();
 
 		
-		int casted{ static_cast<int>(Project::GetCalculationContext().Hydropathy.WindowSize) };
+		int casted{ static_cast<int>(Project::GetCalculationContext().Hydropathy.WindowSize.Get()) };
 		if (ImGui::InputInt("##windowSlider", &casted, 0, 0))
 		{
 			casted = casted < 3 ? 3 : casted;
 			casted = casted % 2 == 0 ? casted + 1 : casted;
 
-			Project::GetCalculationContext().Hydropathy.WindowSize = static_cast<size_t>(casted);
+			Project::GetCalculationContext().Hydropathy.WindowSize.Set(static_cast<size_t>(casted));
 			Project::RecalculateHydropathy();
 		}
 
@@ -362,7 +428,7 @@ void PropertiesPanel::RenderDesiredSequenceProperties(
 			if (ImPlot::BeginPlot("Hydropathy (Kyte & Doolittle)", dataPlotSize, dataPlotFlags))
 			{
 				std::vector<double> indices;
-				size_t magicNumber{ Project::GetCalculationContext().Hydropathy.WindowSize / 2U };
+				size_t magicNumber{ Project::GetCalculationContext().Hydropathy.WindowSize.Get() / 2U };
 				
 				for ([[maybe_unused]] const auto _ : hydropathyPlotData.value()->HydropathyIndices)
 					indices.push_back(static_cast<double>(++magicNumber));
@@ -1,86 +1,108 @@
 #include "Project.hpp"
 #include "Elements.hpp"
 #include "Transform.hpp"
+#include "MappedFile.hpp"
+#include "Lz4.hpp"
+#include "DerivedDataCache.hpp"
 
 constinit static std::unique_ptr<Project> s_Project{ nullptr };
 
-void RnaMetadata::DeserializeFrame(RnaMetadata& outMetadata, const uint32_t index, const Bio::RnaSequence& rnaSequence)
-{
-	auto& frame{ outMetadata.Frames[index] };
-	frame.RnaSequence = rnaSequence;
-	frame.AminoSequence = Bio::TranslateNucleotideSequence(rnaSequence);
-
-	auto& aminoSequence{ frame.AminoSequence };
-	auto& proteinCandidates{ frame.ProteinCandidates };
-
-	for (uint32_t i{ 0U }; i < aminoSequence.size(); ++i)
-	{
-		char currentAmino{ aminoSequence[i].AsCharacter() };
+/* Residues per line of exported protein records */
+static constexpr size_t g_ProteinLineWidth{ 60U };
 
-		/* Start */
-		if (currentAmino == 'M')
-		{
-			Bio::AminoSequence candidate;
+/* Sequences formatted in parallel before their text is written out, bounds the memory held by an export */
+static constexpr size_t g_ExportBlockSize{ 1024U };
 
-			do
-			{
-				candidate.emplace_back(Bio::AminoAcid{}.AssignCharacter(currentAmino));
-				++i;
-			} while (i < aminoSequence.size() && (currentAmino = aminoSequence[i].AsCharacter()) != '-');
+template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
+template<class... Ts> overloaded(Ts...)->overloaded<Ts...>;
 
-			proteinCandidates.emplace_back(std::move(candidate));
-		}
-	}
+/* Translation and ORF scanning share a single pass over the codons, every start is kept so the candidates can be reselected */
+template<typename NucleotideSequence, typename Frame>
+static void ScanNucleotideFrame(Frame& frame, const NucleotideSequence& nucleotideSequence)
+{
+	Bio::OpenReadingFrameScanner scanner;
+	frame.AminoSequence = Bio::TranslateNucleotideSequence(nucleotideSequence, scanner);
+	frame.OpenReadingFrameStarts = std::move(scanner.Finish());
+	frame.StartCodonUsages = std::move(scanner.GetCodonUsages());
+	frame.CodonUsage = scanner.GetSequenceCodonUsage();
 }
 
-void DnaMetadata::DeserializeFrame(DnaMetadata& outMetadata, const uint32_t frameIndex, const Bio::DnaSequence& rnaSequence)
+/* Cuts the candidates the ORF flags report out of the scanned starts, only the selected ones are scored */
+template<typename NucleotideSequence, typename Frame>
+static void SelectProteinCandidates(Frame& frame, const NucleotideSequence& nucleotideSequence, const FrameSettings& settings)
 {
-	auto& frame{ outMetadata.Frames[frameIndex] };
-	frame.DnaSequence = rnaSequence;
-	frame.AminoSequence = Bio::TranslateNucleotideSequence(rnaSequence);
+	const std::vector<uint32_t> selection{ Bio::SelectOpenReadingFrames(frame.OpenReadingFrameStarts, settings.OpenReadingFrameFlags) };
+	frame.OpenReadingFrames = Bio::GatherSelection(frame.OpenReadingFrameStarts, selection);
+	frame.CodonUsages = Bio::GatherSelection(frame.StartCodonUsages, selection);
+	frame.ProteinCandidates = Bio::ExtractProteinCandidates(frame.AminoSequence, frame.OpenReadingFrames);
+	frame.CodingPotentials = Bio::CalculateCodingPotentials(nucleotideSequence, frame.OpenReadingFrames, settings.HexamerTable.get());
+}
 
-	auto& aminoSequence{ frame.AminoSequence };
-	auto& proteinCandidates{ frame.ProteinCandidates };
+static void SelectProteinCandidates(AminoMetadata& metadata, const FrameSettings& settings)
+{
+	const std::vector<uint32_t> selection{ Bio::SelectOpenReadingFrames(metadata.OpenReadingFrameStarts, settings.OpenReadingFrameFlags) };
+	metadata.ProteinCandidates = Bio::ExtractProteinCandidates(metadata.AminoSequence, Bio::GatherSelection(metadata.OpenReadingFrameStarts, selection));
+}
 
-	for (uint32_t i{ 0U }; i < aminoSequence.size(); ++i)
-	{
-		char currentAmino{ aminoSequence[i].AsCharacter() };
+template<typename NucleotideSequence, typename Frame>
+static void DeserializeNucleotideFrame(Frame& frame, const NucleotideSequence& nucleotideSequence, const FrameSettings& settings)
+{
+	ScanNucleotideFrame(frame, nucleotideSequence);
+	SelectProteinCandidates(frame, nucleotideSequence, settings);
+}
 
-		/* Start */
-		if (currentAmino == 'M')
-		{
-			Bio::AminoSequence candidate;
+void RnaMetadata::DeserializeFrame(Frame& frame, Bio::RnaSequence&& rnaSequence, const FrameSettings& settings)
+{
+	frame.RnaSequence = std::move(rnaSequence);
+	DeserializeNucleotideFrame(frame, frame.RnaSequence, settings);
+}
 
-			do
-			{
-				candidate.emplace_back(Bio::AminoAcid{}.AssignCharacter(currentAmino));
-				++i;
-			} while (i < aminoSequence.size() && (currentAmino = aminoSequence[i].AsCharacter()) != '-');
+void DnaMetadata::DeserializeFrame(Frame& frame, Bio::DnaSequence&& dnaSequence, const FrameSettings& settings)
+{
+	frame.DnaSequence = std::move(dnaSequence);
+	DeserializeNucleotideFrame(frame, frame.DnaSequence, settings);
+}
 
-			proteinCandidates.emplace_back(std::move(candidate));
-		}
-	}
+void AminoMetadata::DeserializeCandidates(AminoMetadata& outMetadata, const FrameSettings& settings)
+{
+	outMetadata.OpenReadingFrameStarts = Bio::ScanOpenReadingFrameStarts(outMetadata.AminoSequence);
+	SelectProteinCandidates(outMetadata, settings);
 }
 
 void Project::InvalidateSelectionContext(const ESequenceSelectionType selectionType, const ID sequenceID, const ID frameIndex, const ID peptideID)
 {
-	if (s_SelectionContext.Type != selectionType || s_SelectionContext.Sequence != sequenceID || s_SelectionContext.Frame != frameIndex)
-	{
-		s_NucleotideSequenceCache.reset();
-		s_NucleotideSequencePeptideCache.reset();
-		s_AminoSequenceCache.reset();
-		s_AminoSequencePeptideCache.reset();
-	}
-	else if (s_SelectionContext.Peptide != peptideID)
-	{
-		s_NucleotideSequencePeptideCache.reset();
-		s_AminoSequencePeptideCache.reset();
-	}
+	if (sequenceID != g_InvalidID)
+		MaterializeSequence(sequenceID);
 
 	s_SelectionContext.Type = selectionType;
 	s_SelectionContext.Sequence = sequenceID;
 	s_SelectionContext.Frame = frameIndex;
 	s_SelectionContext.Peptide = peptideID;
+
+	/* Whatever isn't restored from a recent selection is calculated by OnSequenceSelected */
+	s_NucleotideSequenceCache		 = nullptr;
+	s_NucleotideSequencePeptideCache = nullptr;
+	s_AminoSequenceCache			 = nullptr;
+	s_AminoSequencePeptideCache		 = nullptr;
+
+	if (sequenceID != g_InvalidID)
+	{
+		if (auto* const selectionCache{ s_SelectionCaches.Find(SelectedCacheKey()) })
+		{
+			const auto restore{ [peptideID](auto& entry, auto*& sequenceCache, auto*& peptideCache)
+			{
+				sequenceCache = &entry.SequenceCache;
+				if (const auto cachedPeptide{ entry.PeptideCaches.find(peptideID) }; cachedPeptide != entry.PeptideCaches.end())
+					peptideCache = &cachedPeptide->second;
+			} };
+
+			std::visit(overloaded
+			{
+				[&](NucleotideSelectionCacheEntry& entry) { restore(entry, s_NucleotideSequenceCache, s_NucleotideSequencePeptideCache); },
+				[&](AminoSelectionCacheEntry& entry) { restore(entry, s_AminoSequenceCache, s_AminoSequencePeptideCache); }
+			}, *selectionCache);
+		}
+	}
 #ifdef _DEBUG
 	if (frameIndex != g_InvalidID)
 		BIO_ASSERT(sequenceID != g_InvalidID);
@@ -103,6 +125,22 @@ void Project::InvalidateSelectionContext(const ESequenceSelectionType selectionT
 		callback();
 }
 
+void Project::EvictSelectionCaches(const ID sequenceID)
+{
+	if (s_SelectionContext.Sequence == sequenceID)
+	{
+		s_NucleotideSequenceCache		 = nullptr;
+		s_NucleotideSequencePeptideCache = nullptr;
+		s_AminoSequenceCache			 = nullptr;
+		s_AminoSequencePeptideCache		 = nullptr;
+	}
+
+	s_SelectionCaches.EraseIf([sequenceID](const SelectionCacheKey& key)
+	{
+		return key.Sequence == sequenceID;
+	});
+}
+
 void Project::SetPathCallback(const std::function<std::filesystem::path()> callback) noexcept
 {
 	s_PathCallbackFunction = callback;
@@ -125,233 +163,956 @@ std::unique_ptr<Project>& Project::Get()
 	return s_Project;
 }
 
-ID Project::GenerateUUID() noexcept
+Project::CalculationSettingsContext& Project::GetCalculationContext() noexcept
 {
-	static constinit ID f_Counter{ 0U };
-	return ++f_Counter;
+	return s_CalculationContext;
 }
 
-template<class... Ts> struct overloaded : Ts... { using Ts::operator()...; };
-template<class... Ts> overloaded(Ts...)->overloaded<Ts...>;
+void Project::LoadHexamerTable(const std::filesystem::path& path)
+{
+	std::ifstream input(path, std::ios::binary);
 
-Project::CalculationSettingsContext& Project::GetCalculationContext() noexcept
+	BIO_UNLIKELY
+	if (!input.is_open())
+		THROW_EXCEPTION("Failed to open hexamer table");
+
+	auto hexamerTable{ std::make_shared<Bio::HexamerTable>() };
+
+	BIO_UNLIKELY
+	if (!hexamerTable->Load(input))
+		THROW_EXCEPTION("Invalid hexamer table");
+
+	s_HexamerTable = std::move(hexamerTable);
+	RecalculateCodingPotentials();
+}
+
+void Project::LoadCodonAdaptationTable(const std::filesystem::path& path)
 {
-	return s_CalculationContext;
+	std::ifstream input(path, std::ios::binary);
+
+	BIO_UNLIKELY
+	if (!input.is_open())
+		THROW_EXCEPTION("Failed to open codon usage table");
+
+	auto codonAdaptationTable{ std::make_unique<Bio::CodonAdaptationTable>() };
+
+	BIO_UNLIKELY
+	if (!codonAdaptationTable->Load(input))
+		THROW_EXCEPTION("Invalid codon usage table");
+
+	s_CodonAdaptationTable = std::move(codonAdaptationTable);
+	ResetCache();
 }
 
-void Project::RecalculateHydropathy() noexcept
+void Project::SetCodonAdaptationReference(const Bio::CodonUsage& reference)
 {
-	if (Project::SelectedSequence())
+	s_CodonAdaptationTable = std::make_unique<Bio::CodonAdaptationTable>(reference);
+	ResetCache();
+}
+
+Bio::CodonUsage Project::CalculateCodonUsage(const bool likelyCodingOnly)
+{
+	MaterializeSequences();
+
+	const auto frameCodonUsage
 	{
-		switch (Project::SelectedSequenceType())
+		[likelyCodingOnly](const auto& frame)
 		{
-			case ESequenceSelectionType::NucleotideSequence:
-			{
-				if (s_NucleotideSequenceCache.has_value())
-				{
-					{
-						Bio::HydropathyPlotData plotData;
-						if (Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(s_NucleotideSequenceCache->AminoSequence), s_CalculationContext.Hydropathy.WindowSize, plotData))
-						{
-							s_NucleotideSequenceCache->HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-								(
-									HydropathyPlotData_t
-									{
-										.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
-										.MaxScore{ std::move(plotData.maxScore) },
-										.MinScore{ std::move(plotData.minScore) }
-									}
-							);
-						}
-						else
-							s_NucleotideSequenceCache->HydropathyPlotData.reset();
-					}
+			if (!likelyCodingOnly)
+				return frame.CodonUsage;
 
-					if (Project::SelectedPeptide() && s_NucleotideSequencePeptideCache.has_value())
-					{
-						Bio::HydropathyPlotData plotDataPeptide;
-						if (Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(s_NucleotideSequencePeptideCache->ProteinCandidate), s_CalculationContext.Hydropathy.WindowSize, plotDataPeptide))
-						{
-							s_NucleotideSequencePeptideCache->HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-								(
-									HydropathyPlotData_t
-									{
-										.HydropathyIndices{ std::move(plotDataPeptide.hydropathyIndices) },
-										.MaxScore{ std::move(plotDataPeptide.maxScore) },
-										.MinScore{ std::move(plotDataPeptide.minScore) }
-									}
-							);
-						}
-						else
-							s_NucleotideSequencePeptideCache->HydropathyPlotData.reset();
-					}
-				}
-			} break;
+			Bio::CodonUsage codonUsage;
+			for (size_t i{ 0U }; i < frame.CodonUsages.size() && i < frame.CodingPotentials.size(); ++i)
+				if (frame.CodingPotentials[i].Fickett >= Bio::g_FickettCodingThreshold)
+					codonUsage += frame.CodonUsages[i];
 
-			case ESequenceSelectionType::AminoSequence:
-			{
-				if (s_AminoSequenceCache.has_value())
-				{
-					{
-						Bio::HydropathyPlotData plotData;
-						if (Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(s_AminoSequenceCache->AminoSequence), s_CalculationContext.Hydropathy.WindowSize, plotData))
-						{
-							s_AminoSequenceCache->HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-							(
-								HydropathyPlotData_t
-								{
-									.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
-									.MaxScore{ std::move(plotData.maxScore) },
-									.MinScore{ std::move(plotData.minScore) }
-								}
-							);
-						}
-						else
-							s_AminoSequenceCache->HydropathyPlotData.reset();
-					}
+			return codonUsage;
+		}
+	};
 
-					if (Project::SelectedPeptide() && s_AminoSequencePeptideCache.has_value())
-					{
-						Bio::HydropathyPlotData plotDataPeptide;
-						if (Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(s_AminoSequencePeptideCache->ProteinCandidate), s_CalculationContext.Hydropathy.WindowSize, plotDataPeptide))
-						{
-							s_AminoSequencePeptideCache->HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-							(
-								HydropathyPlotData_t
-								{
-									.HydropathyIndices{ std::move(plotDataPeptide.hydropathyIndices) },
-									.MaxScore{ std::move(plotDataPeptide.maxScore) },
-									.MinScore{ std::move(plotDataPeptide.minScore) }
-								}
-							);
-						}
-						else
-							s_AminoSequencePeptideCache->HydropathyPlotData.reset();
-					}
-				}
-			} break;
+	/* Each sequence is histogrammed on its own, partial histograms are summed by the reduction, peptides have no codons */
+	const auto sequenceCodonUsage
+	{
+		[&frameCodonUsage](const auto& metadata)
+		{
+			Bio::CodonUsage codonUsage;
+			for (const auto& frame : *metadata.Frames)
+				codonUsage += frameCodonUsage(frame);
 
-			default:
-				BIO_ASSERT(false);
-				break;
+			return codonUsage;
 		}
+	};
+
+	const std::vector<DnaMetadata>& dnaSequences{ s_SequenceRegistry.GetValues<DnaMetadata>() };
+	const std::vector<RnaMetadata>& rnaSequences{ s_SequenceRegistry.GetValues<RnaMetadata>() };
+	return
+		std::transform_reduce(std::execution::par, dnaSequences.begin(), dnaSequences.end(), Bio::CodonUsage{}, std::plus<>{}, sequenceCodonUsage) +
+		std::transform_reduce(std::execution::par, rnaSequences.begin(), rnaSequences.end(), Bio::CodonUsage{}, std::plus<>{}, sequenceCodonUsage);
+}
+
+template<typename RebuildFrame>
+void Project::RebuildFrames(const RebuildFrame& rebuildFrame)
+{
+	/* Copies are rebuilt once per set of shared frames */
+	std::unordered_map<const DnaMetadata::FrameArray*, std::shared_ptr<DnaMetadata::FrameArray>> dnaFrames;
+	std::unordered_map<const RnaMetadata::FrameArray*, std::shared_ptr<RnaMetadata::FrameArray>> rnaFrames;
+	for (const DnaMetadata& dnaMetadata : s_SequenceRegistry.GetValues<DnaMetadata>())
+		if (dnaMetadata.Frames != DnaMetadata::EmptyFrames())
+			dnaFrames.try_emplace(dnaMetadata.Frames.get(), dnaMetadata.Frames);
+
+	for (const RnaMetadata& rnaMetadata : s_SequenceRegistry.GetValues<RnaMetadata>())
+		if (rnaMetadata.Frames != RnaMetadata::EmptyFrames())
+			rnaFrames.try_emplace(rnaMetadata.Frames.get(), rnaMetadata.Frames);
+
+	/* Every task only writes its own copy */
+	std::for_each(std::execution::par, dnaFrames.begin(), dnaFrames.end(), [&rebuildFrame](auto& frames)
+	{
+		frames.second = std::make_shared<DnaMetadata::FrameArray>(*frames.second);
+		for (auto& frame : *frames.second)
+			rebuildFrame(frame);
+	});
+
+	std::for_each(std::execution::par, rnaFrames.begin(), rnaFrames.end(), [&rebuildFrame](auto& frames)
+	{
+		frames.second = std::make_shared<RnaMetadata::FrameArray>(*frames.second);
+		for (auto& frame : *frames.second)
+			rebuildFrame(frame);
+	});
+
+	s_SharedDnaFrames.clear();
+	s_SharedRnaFrames.clear();
+	for (DnaMetadata& dnaMetadata : s_SequenceRegistry.GetValues<DnaMetadata>())
+	{
+		if (const auto frames{ dnaFrames.find(dnaMetadata.Frames.get()) }; frames != dnaFrames.end())
+			dnaMetadata.Frames = frames->second;
+
+		ShareFrames(dnaMetadata);
+	}
+
+	for (RnaMetadata& rnaMetadata : s_SequenceRegistry.GetValues<RnaMetadata>())
+	{
+		if (const auto frames{ rnaFrames.find(rnaMetadata.Frames.get()) }; frames != rnaFrames.end())
+			rnaMetadata.Frames = frames->second;
+
+		ShareFrames(rnaMetadata);
 	}
 }
 
-void Project::RecalculateNetCharge() noexcept
+void Project::RecalculateCodingPotentials()
 {
-	if (Project::SelectedSequence())
+	const Bio::HexamerTable* const hexamerTable{ s_HexamerTable.get() };
+	RebuildFrames([hexamerTable](auto& frame)
 	{
-		switch (Project::SelectedSequenceType())
-		{
-		case ESequenceSelectionType::NucleotideSequence:
+		frame.CodingPotentials = Bio::CalculateCodingPotentials(frame.GetSequence(), frame.OpenReadingFrames, hexamerTable);
+	});
+
+	ResetCache();
+}
+
+void Project::RecalculateProteinCandidates()
+{
+	/* Pending sequences are selected with the new flags once they're decoded */
+	const FrameSettings settings{ GetFrameSettings() };
+	RebuildFrames([&settings](auto& frame)
+	{
+		SelectProteinCandidates(frame, frame.GetSequence(), settings);
+	});
+
+	/* Autosaves write peptides from their own copies */
+	for (AminoMetadata& aminoMetadata : s_SequenceRegistry.GetValues<AminoMetadata>())
+		SelectProteinCandidates(aminoMetadata, settings);
+
+	ResetCache();
+
+	/* Candidates are renumbered, the selected one may not exist anymore */
+	if (SelectedPeptide())
+		InvalidateSelectionContext(SelectedSequenceType(), SelectedSequence(), SelectedFrame());
+}
+
+template<typename FrameArray>
+static bool HaveSameFrames(const FrameArray& left, const FrameArray& right)
+{
+	for (size_t frameIndex{ 0U }; frameIndex < g_FrameCount; ++frameIndex)
+	{
+		const auto& leftSequence{ left[frameIndex].GetSequence() };
+		const auto& rightSequence{ right[frameIndex].GetSequence() };
+
+		/* Candidates of text projects are kept as they were stored until the ORF flags change, equal sequences with different ones are kept apart */
+		const bool isSame
 		{
-			if (s_NucleotideSequenceCache.has_value())
+			std::equal(leftSequence.begin(), leftSequence.end(), rightSequence.begin(), rightSequence.end(), [](const auto leftNucleotide, const auto rightNucleotide)
+			{
+				return leftNucleotide.AsState() == rightNucleotide.AsState();
+			}) &&
+			std::equal(left[frameIndex].OpenReadingFrames.begin(), left[frameIndex].OpenReadingFrames.end(), right[frameIndex].OpenReadingFrames.begin(), right[frameIndex].OpenReadingFrames.end(), [](const Bio::OpenReadingFrame& leftFrame, const Bio::OpenReadingFrame& rightFrame)
 			{
-				s_NucleotideSequenceCache->NetCharge = Bio::CalculateNetCharge(s_NucleotideSequenceCache->AminoSequence, s_CalculationContext.NetCharge.PH);
+				return leftFrame.Begin == rightFrame.Begin && leftFrame.End == rightFrame.End;
+			})
+		};
 
-				if (Project::SelectedPeptide() && s_NucleotideSequencePeptideCache.has_value())
-					s_NucleotideSequencePeptideCache->NetCharge = Bio::CalculateNetCharge(s_NucleotideSequencePeptideCache->ProteinCandidate, s_CalculationContext.NetCharge.PH);
-			}
-		} break;
+		if (!isSame)
+			return false;
+	}
+
+	return true;
+}
+
+template<typename Metadata, typename SharedFrames>
+static void ShareMetadataFrames(Metadata& metadata, SharedFrames& sharedFrames)
+{
+	BIO_UNLIKELY
+	if (metadata.Frames == Metadata::EmptyFrames())
+		return;
+
+	const auto [sharedFrame, isNew] { sharedFrames.try_emplace(metadata.ContentHash, metadata.Frames) };
+	if (isNew)
+		return;
+
+	/* A hash hit is only trusted after comparing the content, on a collision the newest frames take the entry */
+	const auto frames{ sharedFrame->second.lock() };
+	if (frames && (frames == metadata.Frames || HaveSameFrames(*frames, *metadata.Frames)))
+		metadata.Frames = frames;
+	else
+		sharedFrame->second = metadata.Frames;
+}
+
+void Project::ShareFrames(DnaMetadata& dnaMetadata)
+{
+	ShareMetadataFrames(dnaMetadata, s_SharedDnaFrames);
+}
+
+void Project::ShareFrames(RnaMetadata& rnaMetadata)
+{
+	ShareMetadataFrames(rnaMetadata, s_SharedRnaFrames);
+}
+
+void Project::KeepUndecodedSequence(PendingSequence& pendingSequence)
+{
+	try
+	{
+		/* Copied out of the file, which may be replaced by the next save while the sequence is still pending */
+		const std::shared_ptr<const std::string> section{ std::make_shared<const std::string>(pendingSequence.Section()) };
+		pendingSequence.Section = [section]() { return *section; };
+		pendingSequence.Decode = []() -> SequenceTypes { THROW_EXCEPTION("Failed to decode project section"); };
+	}
+	catch (...)
+	{
+		/* The stored section can't be read at all, saves fail until the sequence is removed */
+		HandleExceptions();
+	}
+}
+
+void Project::MaterializeSequence(const ID uuid)
+{
+	const auto pendingSequence{ s_PendingSequences.find(uuid) };
+
+	BIO_LIKELY
+	if (pendingSequence == s_PendingSequences.end())
+		return;
+
+	try
+	{
+		s_SequenceRegistry.Visit(uuid, [&decode = pendingSequence->second.Decode](auto& metadata)
+		{
+			/* The sequence could have been renamed before it was decoded, it was registered with the type it decodes to */
+			std::string sequenceName{ metadata.SequenceName };
+			metadata = std::get<std::decay_t<decltype(metadata)>>(decode());
+			metadata.SequenceName = std::move(sequenceName);
+			ShareFrames(metadata);
+		});
+
+		s_PendingSequences.erase(pendingSequence);
+	}
+	catch (...)
+	{
+		HandleExceptions();
+		KeepUndecodedSequence(pendingSequence->second);
+	}
+}
+
+void Project::MaterializeSequences()
+{
+	BIO_LIKELY
+	if (s_PendingSequences.empty())
+		return;
 
-		case ESequenceSelectionType::AminoSequence:
+	std::vector<ID> sequences;
+	sequences.reserve(s_PendingSequences.size());
+	for (const auto& [sequenceUUID, pendingSequence] : s_PendingSequences)
+		sequences.emplace_back(sequenceUUID);
+
+	/* Every task only replaces its own sequence, the registry and the pending map are only read until all of them finish */
+	std::vector<uint8_t> decoded(sequences.size());
+	std::transform(std::execution::par, sequences.begin(), sequences.end(), decoded.begin(), [](const ID sequenceUUID) -> uint8_t
+	{
+		try
 		{
-			if (s_AminoSequenceCache.has_value())
+			s_SequenceRegistry.Visit(sequenceUUID, [sequenceUUID](auto& metadata)
 			{
-				s_AminoSequenceCache->NetCharge = Bio::CalculateNetCharge(s_AminoSequenceCache->AminoSequence, s_CalculationContext.NetCharge.PH);
+				std::string sequenceName{ metadata.SequenceName };
+				metadata = std::get<std::decay_t<decltype(metadata)>>(s_PendingSequences.at(sequenceUUID).Decode());
+				metadata.SequenceName = std::move(sequenceName);
+			});
 
-				if (Project::SelectedPeptide() && s_AminoSequencePeptideCache.has_value())
-					s_AminoSequencePeptideCache->NetCharge = Bio::CalculateNetCharge(s_AminoSequencePeptideCache->ProteinCandidate, s_CalculationContext.NetCharge.PH);
-			}
-		} break;
+			return true;
+		}
+		catch (...)
+		{
+			HandleExceptions();
+			return false;
+		}
+	});
 
-		default:
-			BIO_ASSERT(false);
-			break;
+	/* The shared frames map isn't thread safe, deduplication runs once everything is decoded, the ones that failed stay pending */
+	for (size_t i{ 0U }; i < sequences.size(); ++i)
+	{
+		BIO_UNLIKELY
+		if (!decoded[i])
+		{
+			KeepUndecodedSequence(s_PendingSequences.at(sequences[i]));
+			continue;
 		}
+
+		s_SequenceRegistry.Visit(sequences[i], [](auto& metadata) { ShareFrames(metadata); });
+		s_PendingSequences.erase(sequences[i]);
 	}
 }
 
-bool Project::OnSequenceSelected(
-	const std::function<void(const NucleotideSequenceCache&)> onNucleotideSequenceSelected,
-	const std::function<void(const NucleotideSequencePeptideCache&)> onNucleotideSequencePeptideSelected,
-	const std::function<void(const AminoSequenceCache&)> onAminoSequenceSelected,
-	const std::function<void(const AminoSequencePeptideCache&)> onAminoSequencePeptideSelected)
+static void AppendProteinRecord(std::string& output, const std::string_view header, const Bio::AminoSequence& protein)
 {
-	RecalculateHydropathy();
-	RecalculateNetCharge();
-	if (Project::SelectedSequence())
+	output += '>';
+	output += header;
+	output += '\n';
+
+	for (size_t lineBegin{ 0U }; lineBegin < protein.size(); lineBegin += g_ProteinLineWidth)
 	{
-		switch (Project::SelectedSequenceType())
+		const size_t lineEnd{ std::min(lineBegin + g_ProteinLineWidth, protein.size()) };
+		for (size_t i{ lineBegin }; i < lineEnd; ++i)
+			output += protein[i].AsCharacter();
+
+		output += '\n';
+	}
+}
+
+size_t Project::ExportProteinCandidates(const std::filesystem::path& path, const ProteinExportFilter& filter)
+{
+	std::ofstream output(path, std::ios::binary);
+
+	BIO_UNLIKELY
+	if (!output.is_open())
+		THROW_EXCEPTION("Failed to open protein export file");
+
+	MaterializeSequences();
+	const std::vector<ID> sequences{ s_SequenceRegistry.GetIDsInCreationOrder() };
+
+	std::atomic<size_t> exportedCount{ 0U };
+	const auto appendFrames
+	{
+		[&filter, &exportedCount](std::string& block, const std::string& sequenceName, const auto& frames)
 		{
-			case ESequenceSelectionType::NucleotideSequence:
+			const std::string_view identifier{ std::string_view{ sequenceName }.substr(0U, sequenceName.find_first_of(" \t")) };
+
+			for (size_t frameIndex{ 0U }; frameIndex < g_FrameCount; ++frameIndex)
 			{
-				BIO_ASSERT(Project::SelectedFrame());
-				if (!s_NucleotideSequenceCache.has_value())
+				const auto& frame{ frames[frameIndex] };
+				for (size_t i{ 0U }; i < frame.ProteinCandidates.size() && i < frame.OpenReadingFrames.size(); ++i)
 				{
-					NucleotideSequenceCache& nucleotideSequenceCache = s_NucleotideSequenceCache.emplace(NucleotideSequenceCache
-					{
-						.SequenceName{},
-						.NucleotideSequence{},
-						.AminoSequence{},
-						.ProteinCandidates{},
-						.ProteinCandidateLengths{},
-						.MolecularWeight{},
-						.IsoeletricPoint{},
-						.NetCharge{},
-					});
+					const Bio::AminoSequence& protein{ frame.ProteinCandidates[i] };
+					const float codingPotential{ i < frame.CodingPotentials.size() ? frame.CodingPotentials[i].Fickett : 0.0f };
+
+					if (protein.size() < filter.MinimumLength || codingPotential < filter.MinimumCodingPotential)
+						continue;
+
+					const Bio::OpenReadingFrame& openReadingFrame{ frame.OpenReadingFrames[i] };
+					const std::string frameNumber{ std::to_string(frameIndex + 1U) };
+
+					std::array<char, 16U> scoreBuffer{};
+					char* const scoreEnd{ std::to_chars(scoreBuffer.data(), scoreBuffer.data() + scoreBuffer.size(), codingPotential, std::chars_format::fixed, 3).ptr };
 
-					const auto& sequence{ s_SequenceRegistry[Project::SelectedSequence()] };
-					std::visit(overloaded
+					const std::string header
 					{
-						[&](const auto& sequenceMetadata)
-						{
-							nucleotideSequenceCache.SequenceName		= sequenceMetadata.GetName();
-							nucleotideSequenceCache.NucleotideSequence	= sequenceMetadata.BakeSequence(Project::SelectedFrame());
-							nucleotideSequenceCache.AminoSequence		= sequenceMetadata.BakeAminoSequence(Project::SelectedFrame());
-							nucleotideSequenceCache.ProteinCandidates	= sequenceMetadata.BakeProteinCandidates(Project::SelectedFrame());
+						std::string{ identifier } + "_f" + frameNumber + "_" + std::to_string(i + 1U) + " " + sequenceName +
+						" frame=" + frameNumber +
+						" nt=" + std::to_string(frameIndex + openReadingFrame.Begin * 3U + 1U) + "-" + std::to_string(frameIndex + openReadingFrame.End * 3U) +
+						" aa=" + std::to_string(protein.size()) +
+						" testcode=" + std::string(scoreBuffer.data(), scoreEnd)
+					};
+
+					AppendProteinRecord(block, header, protein);
+					++exportedCount;
+				}
+			}
+		}
+	};
 
-							nucleotideSequenceCache.ProteinCandidateLengths.resize(nucleotideSequenceCache.ProteinCandidates.size());
-							for (size_t i{ 0U }; i < nucleotideSequenceCache.ProteinCandidates.size(); ++i)
-								nucleotideSequenceCache.ProteinCandidateLengths[i] = static_cast<uint32_t>(nucleotideSequenceCache.ProteinCandidates[i].size());
+	std::vector<std::string> blocks;
+	for (size_t blockBegin{ 0U }; blockBegin < sequences.size(); blockBegin += g_ExportBlockSize)
+	{
+		const auto first{ sequences.begin() + blockBegin };
+		const auto last{ sequences.begin() + std::min(blockBegin + g_ExportBlockSize, sequences.size()) };
 
-							BIO_LIKELY
-							if (!nucleotideSequenceCache.AminoSequence.empty())
-							{
-								const std::string_view sequenceView{ nucleotideSequenceCache.AminoSequence };
-								nucleotideSequenceCache.MolecularWeight = Bio::CalculateMolecularWeight(sequenceView);
-								nucleotideSequenceCache.IsoeletricPoint = Bio::CalculateIsoelectricPoint(sequenceView);
-								nucleotideSequenceCache.NetCharge		= Bio::CalculateNetCharge(sequenceView, s_CalculationContext.NetCharge.PH);
-								nucleotideSequenceCache.Formula			= Bio::GeneratePeptideFormula(sequenceView);
+		blocks.resize(static_cast<size_t>(last - first));
+		std::transform(std::execution::par, first, last, blocks.begin(), [&filter, &exportedCount, &appendFrames](const ID sequenceUUID)
+		{
+			std::string block;
+			s_SequenceRegistry.Visit(sequenceUUID, overloaded
+			{
+				[&block, &appendFrames](const DnaMetadata& dnaMetadata) { appendFrames(block, dnaMetadata.SequenceName, *dnaMetadata.Frames); },
+				[&block, &appendFrames](const RnaMetadata& rnaMetadata) { appendFrames(block, rnaMetadata.SequenceName, *rnaMetadata.Frames); },
 
-								auto isoelectricPlotData{ Bio::GenerateIsoelectricPlotData(sequenceView) };
-								nucleotideSequenceCache.IsoeletricPointPlotData = std::make_shared<IsoelectricPointPlotData_t>
-								(
-									IsoelectricPointPlotData_t
+				[&block, &filter, &exportedCount](const AminoMetadata& aminoMetadata)
+				{
+					const std::string_view identifier{ std::string_view{ aminoMetadata.SequenceName }.substr(0U, aminoMetadata.SequenceName.find_first_of(" \t")) };
+					for (size_t i{ 0U }; i < aminoMetadata.ProteinCandidates.size(); ++i)
+					{
+						const Bio::AminoSequence& protein{ aminoMetadata.ProteinCandidates[i] };
+						if (protein.size() < filter.MinimumLength)
+							continue;
+
+						AppendProteinRecord(block, std::string{ identifier } + "_" + std::to_string(i + 1U) + " " + aminoMetadata.SequenceName + " aa=" + std::to_string(protein.size()), protein);
+						++exportedCount;
+					}
+				}
+			});
+
+			return block;
+		});
+
+		/* One write per sequence, the formatting above is where the time goes */
+		for (const std::string& block : blocks)
+			output.write(block.data(), static_cast<std::streamsize>(block.size()));
+	}
+
+	BIO_UNLIKELY
+	if (!output.flush())
+		THROW_EXCEPTION("Failed to write protein export file");
+
+	return exportedCount;
+}
+
+struct PropertyRow
+{
+	std::string_view SequenceName;
+	size_t Frame;
+	size_t OpenReadingFrame;
+	size_t NucleotideBegin;
+	size_t NucleotideEnd;
+	std::string_view Protein;
+};
+
+template<typename Type>
+static void AppendNumber(std::string& output, const Type value)
+{
+	std::array<char, 32U> buffer;
+	char* const end{ std::to_chars(buffer.data(), buffer.data() + buffer.size(), value).ptr };
+	output.append(buffer.data(), end);
+}
+
+static void AppendNumber(std::string& output, const double value, const int precision)
+{
+	std::array<char, 64U> buffer;
+	char* const end{ std::to_chars(buffer.data(), buffer.data() + buffer.size(), value, std::chars_format::fixed, precision).ptr };
+	output.append(buffer.data(), end);
+}
+
+/* Names come from FASTA headers, tabs would shift the TSV columns and JSON needs its escapes */
+static void AppendPropertyText(std::string& output, const std::string_view text, const Project::EPropertyExportFormat format)
+{
+	for (const char character : text)
+	{
+		if (format == Project::EPropertyExportFormat::Tsv)
+			output += (character == '\t' || character == '\n' || character == '\r') ? ' ' : character;
+		else if (character == '"' || character == '\\')
+		{
+			output += '\\';
+			output += character;
+		}
+		else if (static_cast<unsigned char>(character) < 0x20U)
+		{
+			constexpr std::string_view hexDigits{ "0123456789abcdef" };
+			output += "\\u00";
+			output += hexDigits[static_cast<unsigned char>(character) >> 4U];
+			output += hexDigits[static_cast<unsigned char>(character) & 0xFU];
+		}
+		else
+			output += character;
+	}
+}
+
+static void AppendPropertyRow(std::string& output, const PropertyRow& row, const Project::EPropertyExportFormat format, const double pH)
+{
+	const bool isJson{ format == Project::EPropertyExportFormat::JsonLines };
+	const auto appendField
+	{
+		[&output, isJson](const std::string_view jsonName, const bool isFirst)
+		{
+			if (isJson)
+			{
+				output += isFirst ? "{\"" : ",\"";
+				output += jsonName;
+				output += "\":";
+			}
+			else if (!isFirst)
+				output += '\t';
+		}
+	};
+
+	appendField("sequence", true);
+	if (isJson)
+		output += '"';
+	AppendPropertyText(output, row.SequenceName, format);
+	if (isJson)
+		output += '"';
+
+	appendField("frame", false);
+	AppendNumber(output, row.Frame);
+	appendField("orf", false);
+	AppendNumber(output, row.OpenReadingFrame);
+	appendField("nt_begin", false);
+	AppendNumber(output, row.NucleotideBegin);
+	appendField("nt_end", false);
+	AppendNumber(output, row.NucleotideEnd);
+	appendField("length", false);
+	AppendNumber(output, row.Protein.size());
+
+	appendField("molecular_weight", false);
+	AppendNumber(output, Bio::CalculateMolecularWeight(row.Protein), 3);
+	appendField("isoelectric_point", false);
+	AppendNumber(output, Bio::CalculateIsoelectricPoint(row.Protein), 2);
+	appendField("net_charge", false);
+	AppendNumber(output, Bio::CalculateNetCharge(row.Protein, pH), 3);
+	appendField("extinction_coefficient", false);
+	AppendNumber(output, Bio::CalculateExtinctionCoefficient(row.Protein));
+	appendField("extinction_coefficient_reduced", false);
+	AppendNumber(output, Bio::CalculateExtinctionCoefficientCysteinesReduced(row.Protein));
+
+	appendField("formula", false);
+	if (isJson)
+		output += '"';
+	output += Bio::BakePeptideFormula(Bio::GeneratePeptideFormula(row.Protein));
+	output += isJson ? "\"}\n" : "\n";
+}
+
+size_t Project::ExportProperties(const std::filesystem::path& path, const EPropertyExportFormat format)
+{
+	std::ofstream output(path, std::ios::binary);
+
+	BIO_UNLIKELY
+	if (!output.is_open())
+		THROW_EXCEPTION("Failed to open property export file");
+
+	if (format == EPropertyExportFormat::Tsv)
+		output << "sequence\tframe\torf\tnt_begin\tnt_end\tlength\tmolecular_weight\tisoelectric_point\tnet_charge\textinction_coefficient\textinction_coefficient_reduced\tformula\n";
+
+	MaterializeSequences();
+	const std::vector<ID> sequences{ s_SequenceRegistry.GetIDsInCreationOrder() };
+	const double pH{ s_CalculationContext.NetCharge.PH.Get() };
+
+	std::atomic<size_t> exportedCount{ 0U };
+	const auto appendProtein
+	{
+		[format, pH, &exportedCount](std::string& block, std::string& protein, const PropertyRow& row, const Bio::AminoSequence& aminoSequence)
+		{
+			/* Empty translations have no properties to speak of */
+			BIO_UNLIKELY
+			if (aminoSequence.empty())
+				return;
+
+			protein.resize(aminoSequence.size());
+			for (size_t i{ 0U }; i < aminoSequence.size(); ++i)
+				protein[i] = aminoSequence[i].AsCharacter();
+
+			PropertyRow filledRow{ row };
+			filledRow.Protein = protein;
+			AppendPropertyRow(block, filledRow, format, pH);
+			++exportedCount;
+		}
+	};
+
+	const auto appendFrames
+	{
+		[&appendProtein](std::string& block, std::string& protein, const std::string& sequenceName, const auto& frames)
+		{
+			for (size_t frameIndex{ 0U }; frameIndex < g_FrameCount; ++frameIndex)
+			{
+				const auto& frame{ frames[frameIndex] };
+				appendProtein(block, protein, PropertyRow
+				{
+					.SequenceName{ sequenceName },
+					.Frame{ frameIndex + 1U },
+					.OpenReadingFrame{ 0U },
+					.NucleotideBegin{ frameIndex + 1U },
+					.NucleotideEnd{ frameIndex + frame.AminoSequence.size() * 3U },
+					.Protein{}
+				},
+				frame.AminoSequence);
+
+				for (size_t i{ 0U }; i < frame.ProteinCandidates.size() && i < frame.OpenReadingFrames.size(); ++i)
+				{
+					const Bio::OpenReadingFrame& openReadingFrame{ frame.OpenReadingFrames[i] };
+					appendProtein(block, protein, PropertyRow
+					{
+						.SequenceName{ sequenceName },
+						.Frame{ frameIndex + 1U },
+						.OpenReadingFrame{ i + 1U },
+						.NucleotideBegin{ frameIndex + openReadingFrame.Begin * 3U + 1U },
+						.NucleotideEnd{ frameIndex + openReadingFrame.End * 3U },
+						.Protein{}
+					},
+					frame.ProteinCandidates[i]);
+				}
+			}
+		}
+	};
+
+	/* Block buffers are kept between batches, once grown they are only refilled */
+	std::vector<std::string> blocks;
+	std::vector<size_t> indices;
+	for (size_t blockBegin{ 0U }; blockBegin < sequences.size(); blockBegin += g_ExportBlockSize)
+	{
+		const size_t blockEnd{ std::min(blockBegin + g_ExportBlockSize, sequences.size()) };
+
+		blocks.resize(std::max(blocks.size(), blockEnd - blockBegin));
+		indices.resize(blockEnd - blockBegin);
+		std::iota(indices.begin(), indices.end(), 0U);
+
+		std::for_each(std::execution::par, indices.begin(), indices.end(), [&sequences, &blocks, &appendFrames, &appendProtein, blockBegin](const size_t index)
+		{
+			std::string& block{ blocks[index] };
+			std::string protein;
+			block.clear();
+
+			s_SequenceRegistry.Visit(sequences[blockBegin + index], overloaded
+			{
+				[&block, &protein, &appendFrames](const DnaMetadata& dnaMetadata) { appendFrames(block, protein, dnaMetadata.SequenceName, *dnaMetadata.Frames); },
+				[&block, &protein, &appendFrames](const RnaMetadata& rnaMetadata) { appendFrames(block, protein, rnaMetadata.SequenceName, *rnaMetadata.Frames); },
+
+				[&block, &protein, &appendProtein](const AminoMetadata& aminoMetadata)
+				{
+					appendProtein(block, protein, PropertyRow{ .SequenceName{ aminoMetadata.SequenceName }, .Frame{ 0U }, .OpenReadingFrame{ 0U }, .NucleotideBegin{ 0U }, .NucleotideEnd{ 0U }, .Protein{} }, aminoMetadata.AminoSequence);
+
+					for (size_t i{ 0U }; i < aminoMetadata.ProteinCandidates.size(); ++i)
+						appendProtein(block, protein, PropertyRow{ .SequenceName{ aminoMetadata.SequenceName }, .Frame{ 0U }, .OpenReadingFrame{ i + 1U }, .NucleotideBegin{ 0U }, .NucleotideEnd{ 0U }, .Protein{} }, aminoMetadata.ProteinCandidates[i]);
+				}
+			});
+		});
+
+		for (size_t i{ 0U }; i < indices.size(); ++i)
+			output.write(blocks[i].data(), static_cast<std::streamsize>(blocks[i].size()));
+	}
+
+	BIO_UNLIKELY
+	if (!output.flush())
+		THROW_EXCEPTION("Failed to write property export file");
+
+	return exportedCount;
+}
+
+/* Same as the hash of the baked text the selection caches are keyed by */
+static uint64_t HashAminoText(const Bio::AminoSequence& aminoSequence) noexcept
+{
+	return Bio::HashBytes(aminoSequence, [](const Bio::AminoAcid amino) { return static_cast<uint8_t>(amino.AsCharacter()); });
+}
+
+std::optional<std::vector<uint64_t>> Project::GetDerivedDataHashes()
+{
+	BIO_UNLIKELY
+	if (!s_PendingSequences.empty())
+		return std::nullopt;
+
+	std::vector<uint64_t> hashes;
+	const auto appendHashes
+	{
+		[&hashes](const Bio::AminoSequence& aminoSequence, const std::vector<Bio::AminoSequence>& proteinCandidates)
+		{
+			hashes.emplace_back(HashAminoText(aminoSequence));
+			for (const Bio::AminoSequence& proteinCandidate : proteinCandidates)
+				hashes.emplace_back(HashAminoText(proteinCandidate));
+		}
+	};
+
+	/* Duplicates share their frames, those are only hashed once */
+	std::set<const void*> hashedFrames;
+	ForEachSequence(overloaded
+	{
+		[&](const ID, const AminoMetadata& aminoMetadata)
+		{
+			appendHashes(aminoMetadata.AminoSequence, aminoMetadata.ProteinCandidates);
+		},
+
+		[&](const ID, const auto& metadata)
+		{
+			if (hashedFrames.insert(metadata.Frames.get()).second)
+				for (const auto& frame : *metadata.Frames)
+					appendHashes(frame.AminoSequence, frame.ProteinCandidates);
+		}
+	});
+
+	std::sort(hashes.begin(), hashes.end());
+	hashes.erase(std::unique(hashes.begin(), hashes.end()), hashes.end());
+	return hashes;
+}
+
+/* Selection results are looked up in the derived data cache by the content hash of the sequence, computed and stored on a miss */
+static double CalculateCachedIsoelectricPoint(const uint64_t contentHash, const std::string_view protein)
+{
+	const DerivedDataCache::Key key{ .Hash{ contentHash }, .Kind{ DerivedDataCache::EKind::IsoelectricPoint }, .Parameter{ 0U } };
+	const std::optional<std::vector<double>> cached{ DerivedDataCache::Find(key) };
+
+	BIO_LIKELY
+	if (cached && cached->size() == 1U)
+		return cached->front();
+
+	const double isoelectricPoint{ Bio::CalculateIsoelectricPoint(protein) };
+	DerivedDataCache::Store(key, { isoelectricPoint });
+	return isoelectricPoint;
+}
+
+static double CalculateCachedNetCharge(const uint64_t contentHash, const std::string_view protein, const float pH)
+{
+	const DerivedDataCache::Key key{ .Hash{ contentHash }, .Kind{ DerivedDataCache::EKind::NetCharge }, .Parameter{ std::bit_cast<uint32_t>(pH) } };
+	const std::optional<std::vector<double>> cached{ DerivedDataCache::Find(key) };
+
+	BIO_LIKELY
+	if (cached && cached->size() == 1U)
+		return cached->front();
+
+	const double netCharge{ Bio::CalculateNetCharge(protein, pH) };
+	DerivedDataCache::Store(key, { netCharge });
+	return netCharge;
+}
+
+static std::pair<std::vector<double>, std::vector<double>> GenerateCachedIsoelectricPlotData(const uint64_t contentHash, const std::string_view protein)
+{
+	const DerivedDataCache::Key key{ .Hash{ contentHash }, .Kind{ DerivedDataCache::EKind::IsoelectricCurve }, .Parameter{ 0U } };
+	std::optional<std::vector<double>> cached{ DerivedDataCache::Find(key) };
+
+	BIO_LIKELY
+	if (cached && cached->size() % 2U == 0U)
+	{
+		const auto middle{ cached->begin() + static_cast<std::ptrdiff_t>(cached->size() / 2U) };
+		return { std::vector<double>(cached->begin(), middle), std::vector<double>(middle, cached->end()) };
+	}
+
+	auto plotData{ Bio::GenerateIsoelectricPlotData(protein) };
+
+	std::vector<double> values;
+	values.reserve(plotData.first.size() + plotData.second.size());
+	values.insert(values.end(), plotData.first.begin(), plotData.first.end());
+	values.insert(values.end(), plotData.second.begin(), plotData.second.end());
+	DerivedDataCache::Store(key, std::move(values));
+
+	return plotData;
+}
+
+static bool GenerateCachedHydropathyPlotData(const uint64_t contentHash, const std::string_view protein, const size_t window, Bio::HydropathyPlotData& data)
+{
+	const DerivedDataCache::Key key{ .Hash{ contentHash }, .Kind{ DerivedDataCache::EKind::Hydropathy }, .Parameter{ static_cast<uint32_t>(window) } };
+	std::optional<std::vector<double>> cached{ DerivedDataCache::Find(key) };
+
+	BIO_LIKELY
+	if (cached && cached->size() >= 2U)
+	{
+		data.minScore = cached->back();
+		cached->pop_back();
+		data.maxScore = cached->back();
+		cached->pop_back();
+		data.hydropathyIndices = std::move(cached.value());
+		return true;
+	}
+
+	/* Only plots that could be generated are stored, the others fail before any work */
+	BIO_UNLIKELY
+	if (!Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(protein), window, data))
+		return false;
+
+	std::vector<double> values;
+	values.reserve(data.hydropathyIndices.size() + 2U);
+	values.insert(values.end(), data.hydropathyIndices.begin(), data.hydropathyIndices.end());
+	values.push_back(data.maxScore);
+	values.push_back(data.minScore);
+	DerivedDataCache::Store(key, std::move(values));
+
+	return true;
+}
+
+/* Selection caches only recalculate the values whose setting changed since they were calculated */
+template<typename SelectionCache>
+static void UpdateNetCharge(SelectionCache& cache, const std::string_view protein, const VersionedSetting<float>& pH)
+{
+	if (cache.NetChargeVersion == pH.GetVersion())
+		return;
+
+	if (!protein.empty())
+		cache.NetCharge = CalculateCachedNetCharge(cache.ContentHash, protein, pH.Get());
+
+	cache.NetChargeVersion = pH.GetVersion();
+}
+
+template<typename SelectionCache>
+static void UpdateHydropathy(SelectionCache& cache, const std::string_view protein, const VersionedSetting<size_t>& windowSize)
+{
+	if (cache.HydropathyVersion == windowSize.GetVersion())
+		return;
+
+	Bio::HydropathyPlotData plotData;
+	if (GenerateCachedHydropathyPlotData(cache.ContentHash, protein, windowSize.Get(), plotData))
+	{
+		cache.HydropathyPlotData = std::make_shared<Project::HydropathyPlotData_t>
+		(
+			Project::HydropathyPlotData_t
+			{
+				.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
+				.MaxScore{ std::move(plotData.maxScore) },
+				.MinScore{ std::move(plotData.minScore) }
+			}
+		);
+	}
+	else
+		cache.HydropathyPlotData.reset();
+
+	cache.HydropathyVersion = windowSize.GetVersion();
+}
+
+/* Heap bytes held by a selection cache, counted against the budget of the recent selections */
+template<typename SelectionCache>
+static size_t EstimateSelectionCacheSize(const SelectionCache& cache) noexcept
+{
+	size_t size{ sizeof(SelectionCache) + cache.SequenceName.capacity() };
+
+	if constexpr (requires { cache.NucleotideSequence; })
+		size += cache.NucleotideSequence.capacity();
+
+	if constexpr (requires { cache.AminoSequenceThreeLetterCode; })
+		size += cache.AminoSequenceThreeLetterCode.capacity();
+
+	if constexpr (requires { cache.ProteinCandidates; })
+	{
+		size += cache.AminoSequence.capacity() + cache.ProteinCandidateLengths.capacity() * sizeof(uint32_t);
+		for (const std::string& proteinCandidate : cache.ProteinCandidates)
+			size += sizeof(std::string) + proteinCandidate.capacity();
+	}
+	else
+		size += cache.ProteinCandidate.capacity();
+
+	if constexpr (requires { cache.ProteinCandidateCodingPotentials; })
+		size += cache.ProteinCandidateCodingPotentials.capacity() * sizeof(Bio::CodingPotential);
+
+	if (cache.IsoeletricPointPlotData.has_value() && *cache.IsoeletricPointPlotData)
+		size += ((*cache.IsoeletricPointPlotData)->TestValues.capacity() + (*cache.IsoeletricPointPlotData)->TestResults.capacity()) * sizeof(double);
+
+	if (cache.HydropathyPlotData.has_value() && *cache.HydropathyPlotData)
+		size += (*cache.HydropathyPlotData)->HydropathyIndices.capacity() * sizeof(double);
+
+	return size;
+}
+
+template<typename SelectionCacheEntry>
+static size_t EstimateSelectionCacheEntrySize(const SelectionCacheEntry& entry) noexcept
+{
+	size_t size{ EstimateSelectionCacheSize(entry.SequenceCache) };
+	for (const auto& [peptideIndex, peptideCache] : entry.PeptideCaches)
+		size += EstimateSelectionCacheSize(peptideCache);
+
+	return size;
+}
+
+void Project::RecalculateHydropathy() noexcept
+{
+	const VersionedSetting<size_t>& windowSize{ s_CalculationContext.Hydropathy.WindowSize };
+	if (s_NucleotideSequenceCache)
+		UpdateHydropathy(*s_NucleotideSequenceCache, s_NucleotideSequenceCache->AminoSequence, windowSize);
+
+	if (s_NucleotideSequencePeptideCache)
+		UpdateHydropathy(*s_NucleotideSequencePeptideCache, s_NucleotideSequencePeptideCache->ProteinCandidate, windowSize);
+
+	if (s_AminoSequenceCache)
+		UpdateHydropathy(*s_AminoSequenceCache, s_AminoSequenceCache->AminoSequence, windowSize);
+
+	if (s_AminoSequencePeptideCache)
+		UpdateHydropathy(*s_AminoSequencePeptideCache, s_AminoSequencePeptideCache->ProteinCandidate, windowSize);
+}
+
+void Project::RecalculateNetCharge() noexcept
+{
+	const VersionedSetting<float>& pH{ s_CalculationContext.NetCharge.PH };
+	if (s_NucleotideSequenceCache)
+		UpdateNetCharge(*s_NucleotideSequenceCache, s_NucleotideSequenceCache->AminoSequence, pH);
+
+	if (s_NucleotideSequencePeptideCache)
+		UpdateNetCharge(*s_NucleotideSequencePeptideCache, s_NucleotideSequencePeptideCache->ProteinCandidate, pH);
+
+	if (s_AminoSequenceCache)
+		UpdateNetCharge(*s_AminoSequenceCache, s_AminoSequenceCache->AminoSequence, pH);
+
+	if (s_AminoSequencePeptideCache)
+		UpdateNetCharge(*s_AminoSequencePeptideCache, s_AminoSequencePeptideCache->ProteinCandidate, pH);
+}
+
+bool Project::OnSequenceSelected(
+	const std::function<void(const NucleotideSequenceCache&)> onNucleotideSequenceSelected,
+	const std::function<void(const NucleotideSequencePeptideCache&)> onNucleotideSequencePeptideSelected,
+	const std::function<void(const AminoSequenceCache&)> onAminoSequenceSelected,
+	const std::function<void(const AminoSequencePeptideCache&)> onAminoSequencePeptideSelected)
+{
+	RecalculateHydropathy();
+	RecalculateNetCharge();
+	if (Project::SelectedSequence())
+	{
+		switch (Project::SelectedSequenceType())
+		{
+			case ESequenceSelectionType::NucleotideSequence:
+			{
+				BIO_ASSERT(Project::SelectedFrame());
+				if (!s_NucleotideSequenceCache)
+				{
+					auto& selectionCache{ std::get<NucleotideSelectionCacheEntry>(s_SelectionCaches.Emplace(SelectedCacheKey(), std::in_place_type<NucleotideSelectionCacheEntry>)) };
+					NucleotideSequenceCache& nucleotideSequenceCache{ selectionCache.SequenceCache };
+					s_NucleotideSequenceCache = &nucleotideSequenceCache;
+
+					s_SequenceRegistry.Visit(Project::SelectedSequence(), overloaded
+					{
+						[&](const auto& sequenceMetadata)
+						{
+							nucleotideSequenceCache.SequenceName		= sequenceMetadata.GetName();
+							nucleotideSequenceCache.NucleotideSequence	= sequenceMetadata.BakeSequence(Project::SelectedFrame());
+							nucleotideSequenceCache.AminoSequence		= sequenceMetadata.BakeAminoSequence(Project::SelectedFrame());
+							nucleotideSequenceCache.ProteinCandidates	= sequenceMetadata.BakeProteinCandidates(Project::SelectedFrame());
+							nucleotideSequenceCache.ContentHash			= Bio::HashSequence(nucleotideSequenceCache.AminoSequence);
+
+							nucleotideSequenceCache.ProteinCandidateLengths.resize(nucleotideSequenceCache.ProteinCandidates.size());
+							for (size_t i{ 0U }; i < nucleotideSequenceCache.ProteinCandidates.size(); ++i)
+								nucleotideSequenceCache.ProteinCandidateLengths[i] = static_cast<uint32_t>(nucleotideSequenceCache.ProteinCandidates[i].size());
+
+							if constexpr (!std::is_same_v<decltype(sequenceMetadata), const AminoMetadata&>)
+							{
+								const auto& frame{ sequenceMetadata.GetFrame(Project::SelectedFrame()) };
+								nucleotideSequenceCache.ProteinCandidateCodingPotentials = frame.CodingPotentials;
+
+								if (s_CodonAdaptationTable)
+									nucleotideSequenceCache.CodonAdaptationIndex = s_CodonAdaptationTable->Calculate(frame.CodonUsage);
+							}
+
+							BIO_LIKELY
+							if (!nucleotideSequenceCache.AminoSequence.empty())
+							{
+								const std::string_view sequenceView{ nucleotideSequenceCache.AminoSequence };
+								nucleotideSequenceCache.MolecularWeight = Bio::CalculateMolecularWeight(sequenceView);
+								nucleotideSequenceCache.IsoeletricPoint = CalculateCachedIsoelectricPoint(nucleotideSequenceCache.ContentHash, sequenceView);
+								nucleotideSequenceCache.Formula			= Bio::GeneratePeptideFormula(sequenceView);
+
+								auto isoelectricPlotData{ GenerateCachedIsoelectricPlotData(nucleotideSequenceCache.ContentHash, sequenceView) };
+								nucleotideSequenceCache.IsoeletricPointPlotData = std::make_shared<IsoelectricPointPlotData_t>
+								(
+									IsoelectricPointPlotData_t
 									{
 										.TestValues{ std::move(isoelectricPlotData.first) },
 										.TestResults{ std::move(isoelectricPlotData.second) }
 									}
 								);
 
-								if (nucleotideSequenceCache.AminoSequence.size() > s_CalculationContext.Hydropathy.WindowSize)
-								{
-									Bio::HydropathyPlotData plotData;
-									Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(nucleotideSequenceCache.AminoSequence), s_CalculationContext.Hydropathy.WindowSize, plotData);
-
-									nucleotideSequenceCache.HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-									(
-										HydropathyPlotData_t
-										{
-											.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
-											.MaxScore{ std::move(plotData.maxScore) },
-											.MinScore{ std::move(plotData.minScore) }
-										}
-									);
-								}
-								else
-									nucleotideSequenceCache.HydropathyPlotData.reset();
+								UpdateNetCharge(nucleotideSequenceCache, sequenceView, s_CalculationContext.NetCharge.PH);
+								UpdateHydropathy(nucleotideSequenceCache, sequenceView, s_CalculationContext.Hydropathy.WindowSize);
 							}
 							else
 							{
@@ -363,40 +1124,62 @@ bool Project::OnSequenceSelected(
 								nucleotideSequenceCache.HydropathyPlotData.reset();
 							}
 						}
-					},
-					sequence);
+					});
+
+					s_SelectionCaches.Resize(SelectedCacheKey(), EstimateSelectionCacheEntrySize(selectionCache));
 				}
 
-				if (Project::SelectedPeptide() && !s_NucleotideSequencePeptideCache.has_value())
+				if (Project::SelectedPeptide() && !s_NucleotideSequencePeptideCache)
 				{
-					NucleotideSequencePeptideCache& nucleotideSequencePeptideCache = s_NucleotideSequencePeptideCache.emplace(NucleotideSequencePeptideCache
+					auto& selectionCache{ std::get<NucleotideSelectionCacheEntry>(*s_SelectionCaches.Find(SelectedCacheKey())) };
+					NucleotideSequencePeptideCache& nucleotideSequencePeptideCache = selectionCache.PeptideCaches.try_emplace(Project::SelectedPeptide(), NucleotideSequencePeptideCache
 					{
-						.ParentCache{ s_NucleotideSequenceCache.value() },
+						.ParentCache{ *s_NucleotideSequenceCache },
 						.SequenceName{},
 						.ProteinCandidate{},
 						.PeptideIndex{ Project::SelectedPeptide() },
 						.MolecularWeight{},
 						.IsoeletricPoint{},
 						.NetCharge{},
-					});
+					}).first->second;
+					s_NucleotideSequencePeptideCache = &nucleotideSequencePeptideCache;
 
 					nucleotideSequencePeptideCache.SequenceName					= s_NucleotideSequenceCache->SequenceName;
 					nucleotideSequencePeptideCache.ProteinCandidate				= s_NucleotideSequenceCache->ProteinCandidates[Project::SelectedPeptide()];
 					nucleotideSequencePeptideCache.AminoSequenceThreeLetterCode = Bio::ConvertAminoSequenceToThreeLetterCode(Bio::ConvertToAminoSequence(nucleotideSequencePeptideCache.ProteinCandidate));
 					nucleotideSequencePeptideCache.PeptideIndex					= Project::SelectedPeptide();
+					nucleotideSequencePeptideCache.ContentHash					= Bio::HashSequence(nucleotideSequencePeptideCache.ProteinCandidate);
+
+					const ID peptideIndex{ Project::SelectedPeptide() };
+					if (peptideIndex < s_NucleotideSequenceCache->ProteinCandidateCodingPotentials.size())
+						nucleotideSequencePeptideCache.CodingPotential = s_NucleotideSequenceCache->ProteinCandidateCodingPotentials[peptideIndex];
+
+					s_SequenceRegistry.Visit(Project::SelectedSequence(), overloaded
+					{
+						[&](const AminoMetadata&) {},
+						[&](const auto& sequenceMetadata)
+						{
+							const auto& codonUsages{ sequenceMetadata.GetFrame(Project::SelectedFrame()).CodonUsages };
+							if (peptideIndex >= codonUsages.size())
+								return;
+
+							nucleotideSequencePeptideCache.CodonUsage = codonUsages[peptideIndex];
+							if (s_CodonAdaptationTable)
+								nucleotideSequencePeptideCache.CodonAdaptationIndex = s_CodonAdaptationTable->Calculate(codonUsages[peptideIndex]);
+						}
+					});
 
 					BIO_LIKELY
 					if (!nucleotideSequencePeptideCache.ProteinCandidate.empty())
 					{
 						const std::string_view sequenceView{ nucleotideSequencePeptideCache.ProteinCandidate };
 						nucleotideSequencePeptideCache.MolecularWeight				= Bio::CalculateMolecularWeight(sequenceView);
-						nucleotideSequencePeptideCache.IsoeletricPoint				= Bio::CalculateIsoelectricPoint(sequenceView);
-						nucleotideSequencePeptideCache.NetCharge					= Bio::CalculateNetCharge(sequenceView, s_CalculationContext.NetCharge.PH);
+						nucleotideSequencePeptideCache.IsoeletricPoint				= CalculateCachedIsoelectricPoint(nucleotideSequencePeptideCache.ContentHash, sequenceView);
 						nucleotideSequencePeptideCache.ExtinctionCoefficient		= Bio::CalculateExtinctionCoefficient(sequenceView);
 						nucleotideSequencePeptideCache.ExtinctionCoefficientReduced = Bio::CalculateExtinctionCoefficientCysteinesReduced(sequenceView);
 						nucleotideSequencePeptideCache.Formula						= Bio::GeneratePeptideFormula(sequenceView);
 
-						auto isoelectricPlotData{ Bio::GenerateIsoelectricPlotData(sequenceView) };
+						auto isoelectricPlotData{ GenerateCachedIsoelectricPlotData(nucleotideSequencePeptideCache.ContentHash, sequenceView) };
 						nucleotideSequencePeptideCache.IsoeletricPointPlotData = std::make_shared<IsoelectricPointPlotData_t>
 						(
 							IsoelectricPointPlotData_t
@@ -406,23 +1189,8 @@ bool Project::OnSequenceSelected(
 							}
 						);
 
-						if (nucleotideSequencePeptideCache.ProteinCandidate.size() > s_CalculationContext.Hydropathy.WindowSize)
-						{
-							Bio::HydropathyPlotData plotData;
-							Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(nucleotideSequencePeptideCache.ProteinCandidate), s_CalculationContext.Hydropathy.WindowSize, plotData);
-
-							nucleotideSequencePeptideCache.HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-							(
-								HydropathyPlotData_t
-								{
-									.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
-									.MaxScore{ std::move(plotData.maxScore) },
-									.MinScore{ std::move(plotData.minScore) }
-								}
-							);
-						}
-						else
-							nucleotideSequencePeptideCache.HydropathyPlotData.reset();
+						UpdateNetCharge(nucleotideSequencePeptideCache, sequenceView, s_CalculationContext.NetCharge.PH);
+						UpdateHydropathy(nucleotideSequencePeptideCache, sequenceView, s_CalculationContext.Hydropathy.WindowSize);
 					}
 					else
 					{
@@ -433,44 +1201,38 @@ bool Project::OnSequenceSelected(
 						nucleotideSequencePeptideCache.IsoeletricPointPlotData.reset();
 						nucleotideSequencePeptideCache.HydropathyPlotData.reset();
 					}
+
+					s_SelectionCaches.Resize(SelectedCacheKey(), EstimateSelectionCacheEntrySize(selectionCache));
 				}
 
 				if (const auto peptideIndex = Project::SelectedPeptide())
 				{
 					if(onNucleotideSequencePeptideSelected)
-						onNucleotideSequencePeptideSelected(s_NucleotideSequencePeptideCache.value());
+						onNucleotideSequencePeptideSelected(*s_NucleotideSequencePeptideCache);
 				}
 				else
 				{
 					if(onNucleotideSequenceSelected)
-						onNucleotideSequenceSelected(s_NucleotideSequenceCache.value());
+						onNucleotideSequenceSelected(*s_NucleotideSequenceCache);
 				}
 			} break;
 
 			case ESequenceSelectionType::AminoSequence:
 			{
-				if (!s_AminoSequenceCache.has_value())
+				if (!s_AminoSequenceCache)
 				{
-					AminoSequenceCache& aminoSequenceCache = s_AminoSequenceCache.emplace(AminoSequenceCache
-					{
-						.SequenceName{},
-						.AminoSequence{},
-						.AminoSequenceThreeLetterCode{},
-						.ProteinCandidates{},
-						.ProteinCandidateLengths{},
-						.MolecularWeight{},
-						.IsoeletricPoint{},
-						.NetCharge{},
-					});
+					auto& selectionCache{ std::get<AminoSelectionCacheEntry>(s_SelectionCaches.Emplace(SelectedCacheKey(), std::in_place_type<AminoSelectionCacheEntry>)) };
+					AminoSequenceCache& aminoSequenceCache{ selectionCache.SequenceCache };
+					s_AminoSequenceCache = &aminoSequenceCache;
 
-					const auto& sequence{ s_SequenceRegistry[Project::SelectedSequence()] };
-					std::visit(overloaded
+					s_SequenceRegistry.Visit(Project::SelectedSequence(), overloaded
 					{
 						[&](const auto& sequenceMetadata)
 						{
 							aminoSequenceCache.SequenceName		 = sequenceMetadata.GetName();
 							aminoSequenceCache.AminoSequence	 = sequenceMetadata.BakeAminoSequence(Project::SelectedFrame());
 							aminoSequenceCache.ProteinCandidates = sequenceMetadata.BakeProteinCandidates(Project::SelectedFrame());
+							aminoSequenceCache.ContentHash		 = Bio::HashSequence(aminoSequenceCache.AminoSequence);
 							
 							if constexpr (std::is_same_v<decltype(sequenceMetadata), const AminoMetadata&>)
 								aminoSequenceCache.AminoSequenceThreeLetterCode = Bio::ConvertAminoSequenceToThreeLetterCode(sequenceMetadata.AminoSequence);
@@ -484,13 +1246,12 @@ bool Project::OnSequenceSelected(
 							{
 								const std::string_view sequenceView{ aminoSequenceCache.AminoSequence };
 								aminoSequenceCache.MolecularWeight					= Bio::CalculateMolecularWeight(sequenceView);
-								aminoSequenceCache.IsoeletricPoint					= Bio::CalculateIsoelectricPoint(sequenceView);
-								aminoSequenceCache.NetCharge						= Bio::CalculateNetCharge(sequenceView, s_CalculationContext.NetCharge.PH);
+								aminoSequenceCache.IsoeletricPoint					= CalculateCachedIsoelectricPoint(aminoSequenceCache.ContentHash, sequenceView);
 								aminoSequenceCache.ExtinctionCoefficient			= Bio::CalculateExtinctionCoefficient(sequenceView);
 								aminoSequenceCache.ExtinctionCoefficientReduced		= Bio::CalculateExtinctionCoefficientCysteinesReduced(sequenceView);
 								aminoSequenceCache.Formula							= Bio::GeneratePeptideFormula(sequenceView);
 
-								auto isoelectricPlotData{ Bio::GenerateIsoelectricPlotData(sequenceView) };
+								auto isoelectricPlotData{ GenerateCachedIsoelectricPlotData(aminoSequenceCache.ContentHash, sequenceView) };
 								aminoSequenceCache.IsoeletricPointPlotData = std::make_shared<IsoelectricPointPlotData_t>
 								(
 									IsoelectricPointPlotData_t
@@ -500,23 +1261,8 @@ bool Project::OnSequenceSelected(
 									}
 								);
 
-								if (aminoSequenceCache.AminoSequence.size() > s_CalculationContext.Hydropathy.WindowSize)
-								{
-									Bio::HydropathyPlotData plotData;
-									Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(aminoSequenceCache.AminoSequence), s_CalculationContext.Hydropathy.WindowSize, plotData);
-
-									aminoSequenceCache.HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-									(
-										HydropathyPlotData_t
-										{
-											.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
-											.MaxScore{ std::move(plotData.maxScore) },
-											.MinScore{ std::move(plotData.minScore) }
-										}
-									);
-								}
-								else
-									aminoSequenceCache.HydropathyPlotData.reset();
+								UpdateNetCharge(aminoSequenceCache, sequenceView, s_CalculationContext.NetCharge.PH);
+								UpdateHydropathy(aminoSequenceCache, sequenceView, s_CalculationContext.Hydropathy.WindowSize);
 							}
 							else
 							{
@@ -528,40 +1274,43 @@ bool Project::OnSequenceSelected(
 								aminoSequenceCache.HydropathyPlotData.reset();
 							}
 						}
-					},
-					sequence);
+					});
+
+					s_SelectionCaches.Resize(SelectedCacheKey(), EstimateSelectionCacheEntrySize(selectionCache));
 				}
 
-				if (Project::SelectedPeptide() && !s_AminoSequencePeptideCache.has_value())
+				if (Project::SelectedPeptide() && !s_AminoSequencePeptideCache)
 				{
-					AminoSequencePeptideCache& aminoSequencePeptideCache = s_AminoSequencePeptideCache.emplace(AminoSequencePeptideCache
+					auto& selectionCache{ std::get<AminoSelectionCacheEntry>(*s_SelectionCaches.Find(SelectedCacheKey())) };
+					AminoSequencePeptideCache& aminoSequencePeptideCache = selectionCache.PeptideCaches.try_emplace(Project::SelectedPeptide(), AminoSequencePeptideCache
 					{
-						.ParentCache{ s_AminoSequenceCache.value() },
+						.ParentCache{ *s_AminoSequenceCache },
 						.SequenceName{},
 						.ProteinCandidate{},
 						.PeptideIndex{ Project::SelectedPeptide() },
 						.MolecularWeight{},
 						.IsoeletricPoint{},
 						.NetCharge{},
-					});
+					}).first->second;
+					s_AminoSequencePeptideCache = &aminoSequencePeptideCache;
 
 					aminoSequencePeptideCache.SequenceName					= s_AminoSequenceCache->SequenceName;
 					aminoSequencePeptideCache.ProteinCandidate				= s_AminoSequenceCache->ProteinCandidates[Project::SelectedPeptide()];
 					aminoSequencePeptideCache.PeptideIndex					= Project::SelectedPeptide();
 					aminoSequencePeptideCache.AminoSequenceThreeLetterCode	= Bio::ConvertAminoSequenceToThreeLetterCode(Bio::ConvertToAminoSequence(aminoSequencePeptideCache.ProteinCandidate));
+					aminoSequencePeptideCache.ContentHash					= Bio::HashSequence(aminoSequencePeptideCache.ProteinCandidate);
 
 					BIO_LIKELY
 					if (!aminoSequencePeptideCache.ProteinCandidate.empty())
 					{
 						const std::string_view sequenceView{ aminoSequencePeptideCache.ProteinCandidate };
 						aminoSequencePeptideCache.MolecularWeight				= Bio::CalculateMolecularWeight(sequenceView);
-						aminoSequencePeptideCache.IsoeletricPoint				= Bio::CalculateIsoelectricPoint(sequenceView);
-						aminoSequencePeptideCache.NetCharge						= Bio::CalculateNetCharge(sequenceView, s_CalculationContext.NetCharge.PH);
+						aminoSequencePeptideCache.IsoeletricPoint				= CalculateCachedIsoelectricPoint(aminoSequencePeptideCache.ContentHash, sequenceView);
 						aminoSequencePeptideCache.ExtinctionCoefficient			= Bio::CalculateExtinctionCoefficient(sequenceView);
 						aminoSequencePeptideCache.ExtinctionCoefficientReduced	= Bio::CalculateExtinctionCoefficientCysteinesReduced(sequenceView);
 						aminoSequencePeptideCache.Formula						= Bio::GeneratePeptideFormula(sequenceView);
 
-						auto isoelectricPlotData{ Bio::GenerateIsoelectricPlotData(sequenceView) };
+						auto isoelectricPlotData{ GenerateCachedIsoelectricPlotData(aminoSequencePeptideCache.ContentHash, sequenceView) };
 						aminoSequencePeptideCache.IsoeletricPointPlotData = std::make_shared<IsoelectricPointPlotData_t>
 						(
 							IsoelectricPointPlotData_t
@@ -571,23 +1320,8 @@ bool Project::OnSequenceSelected(
 							}
 						);
 
-						if (aminoSequencePeptideCache.ProteinCandidate.size() > s_CalculationContext.Hydropathy.WindowSize)
-						{
-							Bio::HydropathyPlotData plotData;
-							Bio::GenerateHydropathyPlotData(Bio::ConvertToAminoSequence(aminoSequencePeptideCache.ProteinCandidate), s_CalculationContext.Hydropathy.WindowSize, plotData);
-
-							aminoSequencePeptideCache.HydropathyPlotData = std::make_shared<HydropathyPlotData_t>
-							(
-								HydropathyPlotData_t
-								{
-									.HydropathyIndices{ std::move(plotData.hydropathyIndices) },
-									.MaxScore{ std::move(plotData.maxScore) },
-									.MinScore{ std::move(plotData.minScore) }
-								}
-							);
-						}
-						else
-							aminoSequencePeptideCache.HydropathyPlotData.reset();
+						UpdateNetCharge(aminoSequencePeptideCache, sequenceView, s_CalculationContext.NetCharge.PH);
+						UpdateHydropathy(aminoSequencePeptideCache, sequenceView, s_CalculationContext.Hydropathy.WindowSize);
 					}
 					else
 					{
@@ -598,17 +1332,19 @@ bool Project::OnSequenceSelected(
 						aminoSequencePeptideCache.IsoeletricPointPlotData.reset();
 						aminoSequencePeptideCache.HydropathyPlotData.reset();
 					}
+
+					s_SelectionCaches.Resize(SelectedCacheKey(), EstimateSelectionCacheEntrySize(selectionCache));
 				}
 
 				if (const auto peptideIndex = Project::SelectedPeptide())
 				{
 					if(onAminoSequencePeptideSelected)
-						onAminoSequencePeptideSelected(s_AminoSequencePeptideCache.value());
+						onAminoSequencePeptideSelected(*s_AminoSequencePeptideCache);
 				}
 				else
 				{
 					if(onAminoSequenceSelected)
-						onAminoSequenceSelected(s_AminoSequenceCache.value());
+						onAminoSequenceSelected(*s_AminoSequenceCache);
 				}
 			} break;
 
@@ -633,108 +1369,820 @@ ProjectSerializer::ProjectSerializer(std::unique_ptr<Project>& project) noexcept
 	BIO_ASSERT(m_Project);
 }
 
-std::ostream& operator<<(std::ostream& stream, const Bio::DnaSequence& sequence) noexcept
+/*
+* Binary project layout (version 2, little endian):
+*	FileHeader | SectionEntry[SectionCount] | sections | journal
+* Every sequence is one section:
+*	name (uint32 length + bytes)
+*	DNA / RNA: per frame an EFrameStorage, packed frames follow with their uint64 length and two bits per nucleotide
+*	Peptide: uint64 length + one state per residue
+*	with SectionFlags_DerivedData: per frame a uint32 count of ORFs (uint32 Begin, uint32 End, uint8 AlternativeStart)
+*	with SectionFlags_SharedData (DNA / RNA only): a uint32 slot of an earlier section of the same type holding the data
+* Translations, candidates, codon usages and scores aren't stored, they're derived again on load
+* With Codec_Lz4 everything after a section's name is block compressed (see CompressSection)
+*/
+struct FileHeader
 {
-	for (const auto element : sequence)
-		stream << element.AsCharacter();
+	std::array<char, 4U> Magic;
+	uint32_t Version;
+	uint32_t Codec;			/* ECodec of every section (and journal record) in the file */
+	uint32_t SectionCount;
+};
 
-	return stream;
-}
+struct SectionEntry
+{
+	uint32_t Type;
+	uint32_t Flags;
+	uint64_t Offset;
+	uint64_t Size;
+};
 
-std::ostream& operator<<(std::ostream& stream, const Bio::RnaSequence& sequence) noexcept
+static_assert(sizeof(FileHeader) == 16U && sizeof(SectionEntry) == 24U, "Project file structures can't be padded");
+
+enum ESectionType : uint32_t
 {
-	for (const auto element : sequence)
-		stream << element.AsCharacter();
+	SectionType_Dna = 0,
+	SectionType_Rna = 1,
+	SectionType_Peptide = 2
+};
 
-	return stream;
-}
+enum ESectionFlags : uint32_t
+{
+	SectionFlags_None = 0,
+	SectionFlags_DerivedData = 1 << 0,
+	SectionFlags_SharedData = 1 << 1	/* Identical sequences are only stored once, the others point at it */
+};
 
-std::ostream& operator<<(std::ostream& stream, const Bio::AminoSequence& sequence) noexcept
+/* Frames 2 and 3 of an imported sequence are the first frame without its leading nucleotides, those are only marked */
+enum EFrameStorage : uint8_t
+{
+	FrameStorage_Shifted = 0,
+	FrameStorage_Packed = 1
+};
+
+/*
+* Saves over the file a project was opened from or last saved to only append journal records after the sections
+* An added record is followed by its section, slots count every section ever written (the table holds the first SectionCount)
+*/
+struct JournalRecord
 {
-	for (const auto element : sequence)
-		stream << element.AsCharacter();
+	uint32_t Kind;
+	uint32_t Slot;
+	uint32_t Type;
+	uint32_t Flags;
+	uint64_t Size;
+};
 
-	return stream;
-}
+static_assert(sizeof(JournalRecord) == 24U, "Project file structures can't be padded");
 
-void ProjectSerializer::OnSerialize(const std::filesystem::path& path) const
+enum EJournalRecordKind : uint32_t
 {
-	BIO_UNLIKELY
+	JournalRecordKind_Add = 0,
+	JournalRecordKind_Remove = 1
+};
+
+/* The file is compacted (rewritten) once its journal outgrows both of these */
+static constexpr uint64_t g_MinimumCompactedJournalSize{ 16U * 1024U * 1024U };
+static constexpr uint64_t g_CompactedJournalRatio{ 2U };
+
+enum ECodec : uint32_t
+{
+	Codec_None = 0,
+	Codec_Lz4 = 1
+};
+
+/* Uncompressed size of the blocks a section is split into, blocks are (de)compressed in parallel */
+static constexpr size_t g_CompressionBlockSize{ 256_Kb };
+
+static constexpr std::array<char, 4U> g_BinaryMagic{ 'V', 'I', 'S', 'B' };
+static constexpr uint32_t g_BinaryVersion{ 2U };
+
+template<typename Type>
+static void AppendBinary(std::string& output, const Type& value)
+{
+	static_assert(std::is_trivially_copyable_v<Type>);
+	output.append(reinterpret_cast<const char*>(&value), sizeof(Type));
+}
+
+static void AppendName(std::string& output, const std::string& name)
+{
+	AppendBinary(output, static_cast<uint32_t>(name.size()));
+	output += name;
+}
+
+/* Stored ranges can't be trusted to point into the sequence, they are checked before being used */
+static void AppendOpenReadingFrames(std::string& output, const std::vector<Bio::OpenReadingFrame>& openReadingFrames)
+{
+	AppendBinary(output, static_cast<uint32_t>(openReadingFrames.size()));
+	for (const Bio::OpenReadingFrame& openReadingFrame : openReadingFrames)
+	{
+		AppendBinary(output, openReadingFrame.Begin);
+		AppendBinary(output, openReadingFrame.End);
+		AppendBinary(output, static_cast<uint8_t>(openReadingFrame.AlternativeStart));
+	}
+}
+
+/* Bounds checked cursor over a single section */
+class SectionReader
+{
+public:
+	explicit SectionReader(const std::string_view section) noexcept
+		:
+		m_Section(section),
+		m_Position(0U)
+	{}
+
+	template<typename Type>
+	[[nodiscard]] Type Read()
+	{
+		static_assert(std::is_trivially_copyable_v<Type>);
+
+		Type value;
+		std::memcpy(&value, ReadBytes(sizeof(Type)).data(), sizeof(Type));
+		return value;
+	}
+
+	[[nodiscard]] std::string_view ReadBytes(const size_t size)
+	{
+		BIO_UNLIKELY
+		if (size > m_Section.size() - m_Position)
+			THROW_EXCEPTION("Truncated project section");
+
+		const std::string_view bytes{ m_Section.substr(m_Position, size) };
+		m_Position += size;
+		return bytes;
+	}
+
+	[[nodiscard]] size_t GetRemainingSize() const noexcept
+	{
+		return m_Section.size() - m_Position;
+	}
+
+	[[nodiscard]] std::string ReadName()
+	{
+		return std::string{ ReadBytes(Read<uint32_t>()) };
+	}
+
+	[[nodiscard]] std::vector<Bio::OpenReadingFrame> ReadOpenReadingFrames(const size_t aminoSequenceSize)
+	{
+		std::vector<Bio::OpenReadingFrame> openReadingFrames(Read<uint32_t>());
+		for (Bio::OpenReadingFrame& openReadingFrame : openReadingFrames)
+		{
+			openReadingFrame.Begin = Read<uint32_t>();
+			openReadingFrame.End = Read<uint32_t>();
+			openReadingFrame.AlternativeStart = Read<uint8_t>() != 0U;
+
+			BIO_UNLIKELY
+			if (openReadingFrame.Begin >= openReadingFrame.End || openReadingFrame.End > aminoSequenceSize)
+				THROW_EXCEPTION("Invalid open reading frame in project section");
+		}
+
+		return openReadingFrames;
+	}
+private:
+	std::string_view m_Section;
+	size_t m_Position;
+};
+
+/*
+* The name is kept in front as it is (opening a project reads it without decompressing anything), the rest is split into blocks:
+*	uint64 size, uint32 block count, uint32 stored size of every block, blocks
+* Blocks that don't shrink are stored as they are, their stored size is then the block size
+*/
+static std::string CompressSection(const std::string_view section)
+{
+	const size_t nameEnd{ sizeof(uint32_t) + SectionReader{ section }.Read<uint32_t>() };
+	const std::string_view payload{ section.substr(nameEnd) };
+
+	std::vector<size_t> blockIndices((payload.size() + g_CompressionBlockSize - 1U) / g_CompressionBlockSize);
+	std::iota(blockIndices.begin(), blockIndices.end(), size_t{ 0U });
+
+	std::vector<std::string> blocks(blockIndices.size());
+	std::transform(std::execution::par, blockIndices.begin(), blockIndices.end(), blocks.begin(), [payload](const size_t blockIndex)
+	{
+		const std::string_view block{ payload.substr(blockIndex * g_CompressionBlockSize, g_CompressionBlockSize) };
+
+		std::string compressed;
+		Lz4::Compress(block, compressed);
+		return compressed.size() < block.size() ? compressed : std::string{ block };
+	});
+
+	std::string output{ section.substr(0U, nameEnd) };
+	AppendBinary(output, static_cast<uint64_t>(payload.size()));
+	AppendBinary(output, static_cast<uint32_t>(blocks.size()));
+	for (const std::string& block : blocks)
+		AppendBinary(output, static_cast<uint32_t>(block.size()));
+
+	for (const std::string& block : blocks)
+		output += block;
+
+	return output;
+}
+
+static std::string DecompressSection(const std::string_view section)
+{
+	SectionReader reader{ section };
+	const size_t nameEnd{ sizeof(uint32_t) + reader.ReadBytes(reader.Read<uint32_t>()).size() };
+	const uint64_t payloadSize{ reader.Read<uint64_t>() };
+	const uint32_t blockCount{ reader.Read<uint32_t>() };
+
+	/* Both sizes are checked against what the section can hold before anything is allocated from them */
+	BIO_UNLIKELY
+	if (payloadSize > Lz4::DecompressBound(section.size()) || blockCount > reader.GetRemainingSize() / sizeof(uint32_t) ||
+		blockCount != (payloadSize + g_CompressionBlockSize - 1U) / g_CompressionBlockSize)
+		THROW_EXCEPTION("Invalid compressed project section");
+
+	std::vector<uint32_t> storedSizes(blockCount);
+	for (uint32_t& storedSize : storedSizes)
+		storedSize = reader.Read<uint32_t>();
+
+	std::vector<std::string_view> blocks(blockCount);
+	for (uint32_t i{ 0U }; i < blockCount; ++i)
+		blocks[i] = reader.ReadBytes(storedSizes[i]);
+
+	std::string output(nameEnd + static_cast<size_t>(payloadSize), '\0');
+	std::memcpy(output.data(), section.data(), nameEnd);
+
+	std::vector<size_t> blockIndices(blockCount);
+	std::iota(blockIndices.begin(), blockIndices.end(), size_t{ 0U });
+
+	/* Exceptions can't leave the parallel tasks, a malformed block is only flagged */
+	std::atomic<bool> isMalformed{ false };
+	std::for_each(std::execution::par, blockIndices.begin(), blockIndices.end(), [&blocks, &output, &isMalformed, nameEnd, payloadSize](const size_t blockIndex)
+	{
+		const size_t blockBegin{ blockIndex * g_CompressionBlockSize };
+		const size_t blockSize{ std::min(g_CompressionBlockSize, static_cast<size_t>(payloadSize) - blockBegin) };
+		char* const blockOutput{ output.data() + nameEnd + blockBegin };
+
+		try
+		{
+			if (blocks[blockIndex].size() == blockSize)
+				std::memcpy(blockOutput, blocks[blockIndex].data(), blockSize);
+			else
+				Lz4::Decompress(blocks[blockIndex], blockOutput, blockSize);
+		}
+		catch (...)
+		{
+			isMalformed = true;
+		}
+	});
+
+	BIO_UNLIKELY
+	if (isMalformed)
+		THROW_EXCEPTION("Invalid compressed project section");
+
+	return output;
+}
+
+/* Sections of uncompressed files are read straight from the mapping */
+static std::string_view ExpandSection(const std::string_view section, const uint32_t codec, std::string& buffer)
+{
+	BIO_UNLIKELY
+	if (codec == Codec_None)
+		return section;
+
+	buffer = DecompressSection(section);
+	return buffer;
+}
+
+/* Returns whether the frames were stored, otherwise they are left to the scan on load */
+template<typename Metadata, typename GetSequence>
+static bool AppendNucleotideSection(std::string& output, const Metadata& metadata, const GetSequence& getSequence, const bool storeDerivedData)
+{
+	AppendName(output, metadata.SequenceName);
+
+	const auto& frames{ *metadata.Frames };
+	const auto& firstSequence{ getSequence(frames[0U]) };
+	for (size_t frameIndex{ 0U }; frameIndex < g_FrameCount; ++frameIndex)
+	{
+		const auto& sequence{ getSequence(frames[frameIndex]) };
+		const size_t shift{ std::min(frameIndex, firstSequence.size()) };
+
+		const bool isShifted
+		{
+			frameIndex > 0U && sequence.size() == firstSequence.size() - shift &&
+			std::equal(sequence.begin(), sequence.end(), firstSequence.begin() + shift, [](const auto left, const auto right)
+			{
+				return left.AsState() == right.AsState();
+			})
+		};
+
+		if (isShifted)
+		{
+			AppendBinary(output, FrameStorage_Shifted);
+			continue;
+		}
+
+		const std::vector<uint8_t> packed{ Bio::PackNucleotides(sequence) };
+		AppendBinary(output, FrameStorage_Packed);
+		AppendBinary(output, static_cast<uint64_t>(sequence.size()));
+		output.append(reinterpret_cast<const char*>(packed.data()), packed.size());
+	}
+
+	if (!storeDerivedData)
+		return false;
+
+	/* Every start is stored, the candidates are selected from them on load */
+	for (const auto& frame : frames)
+		AppendOpenReadingFrames(output, frame.OpenReadingFrameStarts);
+
+	return true;
+}
+
+template<typename NucleotideSequence, typename Metadata, typename GetSequence>
+static Metadata ReadNucleotideSection(SectionReader& reader, const bool hasDerivedData, const GetSequence& getSequence)
+{
+	using Nucleotide = typename NucleotideSequence::value_type;
+
+	Metadata metadata{ reader.ReadName() };
+	const std::shared_ptr<typename Metadata::FrameArray> frames{ std::make_shared<typename Metadata::FrameArray>() };
+
+	for (size_t frameIndex{ 0U }; frameIndex < g_FrameCount; ++frameIndex)
+	{
+		NucleotideSequence& sequence{ getSequence((*frames)[frameIndex]) };
+
+		switch (reader.Read<uint8_t>())
+		{
+		case FrameStorage_Shifted:
+		{
+			BIO_UNLIKELY
+			if (frameIndex == 0U)
+				THROW_EXCEPTION("Invalid frame storage in project section");
+
+			const NucleotideSequence& firstSequence{ getSequence((*frames)[0U]) };
+			sequence.assign(firstSequence.begin() + std::min(frameIndex, firstSequence.size()), firstSequence.end());
+			break;
+		}
+		case FrameStorage_Packed:
+		{
+			const uint64_t count{ reader.Read<uint64_t>() };
+
+			BIO_UNLIKELY
+			if (count > std::numeric_limits<size_t>::max() / 2U)
+				THROW_EXCEPTION("Truncated project section");
+
+			const std::string_view packed{ reader.ReadBytes((static_cast<size_t>(count) + 3U) / 4U) };
+			sequence = Bio::UnpackNucleotides<Nucleotide>(reinterpret_cast<const uint8_t*>(packed.data()), static_cast<size_t>(count));
+			break;
+		}
+		default:
+			THROW_EXCEPTION("Invalid frame storage in project section");
+		}
+	}
+
+	for (auto& frame : *frames)
+	{
+		const NucleotideSequence& sequence{ getSequence(frame) };
+
+		BIO_LIKELY
+		if (hasDerivedData)
+		{
+			/* Stored frames skip the scan, candidates are selected straight from the stored starts */
+			frame.AminoSequence = Bio::TranslateNucleotideSequence(sequence);
+			frame.OpenReadingFrameStarts = reader.ReadOpenReadingFrames(frame.AminoSequence.size());
+			frame.StartCodonUsages = Bio::CountCodonUsages(sequence, frame.OpenReadingFrameStarts);
+			frame.CodonUsage = Bio::CountCodonUsage(sequence, 0U, sequence.size() / 3U);
+			SelectProteinCandidates(frame, sequence, Project::GetFrameSettings());
+		}
+		else
+			DeserializeNucleotideFrame(frame, sequence, Project::GetFrameSettings());
+	}
+
+	metadata.ContentHash = Bio::HashSequence(getSequence((*frames)[0U]));
+	metadata.Frames = frames;
+	return metadata;
+}
+
+static AminoMetadata ReadPeptideSection(SectionReader& reader, const bool hasDerivedData)
+{
+	AminoMetadata metadata{ reader.ReadName() };
+
+	const std::string_view states{ reader.ReadBytes(static_cast<size_t>(reader.Read<uint64_t>())) };
+	metadata.AminoSequence.resize(states.size());
+	for (size_t i{ 0U }; i < states.size(); ++i)
+	{
+		const uint8_t state{ static_cast<uint8_t>(states[i]) };
+
+		BIO_UNLIKELY
+		if (state >= Bio::AminoAcid::s_AlphabetSize)
+			THROW_EXCEPTION("Invalid amino acid in project section");
+
+		metadata.AminoSequence[i].AssignState(state);
+	}
+
+	BIO_LIKELY
+	if (hasDerivedData)
+	{
+		metadata.OpenReadingFrameStarts = reader.ReadOpenReadingFrames(metadata.AminoSequence.size());
+		SelectProteinCandidates(metadata, Project::GetFrameSettings());
+	}
+	else
+		AminoMetadata::DeserializeCandidates(metadata, Project::GetFrameSettings());
+
+	return metadata;
+}
+
+/* Snapshots keep sequences as variants, the registry hands them out by type */
+template<typename Sequence, typename Visitor>
+static decltype(auto) VisitMetadata(const Sequence& sequence, Visitor&& visitor)
+{
+	if constexpr (requires { sequence.index(); })
+		return std::visit(std::forward<Visitor>(visitor), sequence);
+	else
+		return visitor(sequence);
+}
+
+/* Also fills the type and flags of the section's entry, its placement is left to the caller */
+template<typename Sequence>
+static std::string EncodeSection(const Sequence& sequence, const bool storeDerivedData, SectionEntry& entry)
+{
+	std::string section;
+	bool hasDerivedData{ storeDerivedData };
+
+	VisitMetadata(sequence, overloaded
+	{
+		[&](const DnaMetadata& dnaMetadata)
+		{
+			entry.Type = SectionType_Dna;
+			hasDerivedData = AppendNucleotideSection(section, dnaMetadata, [](const auto& frame) -> const Bio::DnaSequence& { return frame.DnaSequence; }, storeDerivedData);
+		},
+
+		[&](const RnaMetadata& rnaMetadata)
+		{
+			entry.Type = SectionType_Rna;
+			hasDerivedData = AppendNucleotideSection(section, rnaMetadata, [](const auto& frame) -> const Bio::RnaSequence& { return frame.RnaSequence; }, storeDerivedData);
+		},
+
+		[&](const AminoMetadata& aminoMetadata)
+		{
+			entry.Type = SectionType_Peptide;
+			AppendName(section, aminoMetadata.SequenceName);
+
+			AppendBinary(section, static_cast<uint64_t>(aminoMetadata.AminoSequence.size()));
+			for (const Bio::AminoAcid amino : aminoMetadata.AminoSequence)
+				AppendBinary(section, static_cast<uint8_t>(amino.AsState()));
+
+			if (hasDerivedData)
+				AppendOpenReadingFrames(section, aminoMetadata.OpenReadingFrameStarts);
+		},
+
+		[](const auto& arg) { BIO_ASSERT(false); (void)arg; }
+	});
+
+	entry.Flags = hasDerivedData ? SectionFlags_DerivedData : SectionFlags_None;
+
+	return section;
+}
+
+template<typename Sequence>
+static std::string EncodeSharedSection(const Sequence& sequence, const uint32_t dataSlot, SectionEntry& entry)
+{
+	std::string section;
+
+	VisitMetadata(sequence, overloaded
+	{
+		[&section, &entry](const DnaMetadata& dnaMetadata)
+		{
+			entry.Type = SectionType_Dna;
+			AppendName(section, dnaMetadata.SequenceName);
+		},
+
+		[&section, &entry](const RnaMetadata& rnaMetadata)
+		{
+			entry.Type = SectionType_Rna;
+			AppendName(section, rnaMetadata.SequenceName);
+		},
+
+		[](const auto& arg) { BIO_ASSERT(false); (void)arg; }
+	});
+
+	AppendBinary(section, dataSlot);
+	entry.Flags = SectionFlags_SharedData;
+
+	return section;
+}
+
+/* Identity of the frames a sequence shares with its duplicates, nothing for peptides and sequences without frames */
+template<typename Sequence>
+static const void* GetSharedFrames(const Sequence& sequence)
+{
+	return VisitMetadata(sequence, overloaded
+	{
+		[](const DnaMetadata& dnaMetadata) -> const void* { return dnaMetadata.Frames != DnaMetadata::EmptyFrames() ? dnaMetadata.Frames.get() : nullptr; },
+		[](const RnaMetadata& rnaMetadata) -> const void* { return rnaMetadata.Frames != RnaMetadata::EmptyFrames() ? rnaMetadata.Frames.get() : nullptr; },
+		[](const AminoMetadata&) -> const void* { return nullptr; }
+	});
+}
+
+static constexpr uint32_t g_InvalidSlot{ std::numeric_limits<uint32_t>::max() };
+
+/* A sequence that was never decoded gets its stored section back under its current name */
+static std::string RenameStoredSection(const std::string_view storedSection, const std::string& sequenceName)
+{
+	const size_t nameEnd{ sizeof(uint32_t) + SectionReader{ storedSection }.ReadName().size() };
+
+	std::string section;
+	AppendName(section, sequenceName);
+	section.append(storedSection.substr(nameEnd));
+	return section;
+}
+
+uint64_t ProjectSerializer::WriteBinary(std::ofstream& output, const ProjectSnapshot& snapshot, const bool storeDerivedData)
+{
+	const std::vector<ProjectSnapshot::Sequence>& sequences{ snapshot.m_Sequences };
+
+	/* The first sequence with a set of frames stores them, its duplicates refer to its slot */
+	std::vector<uint32_t> dataSlots(sequences.size(), g_InvalidSlot);
+	std::unordered_map<const void*, uint32_t> frameSlots;
+	for (size_t i{ 0U }; i < sequences.size(); ++i)
+	{
+		const void* const frames{ GetSharedFrames(sequences[i].Metadata) };
+		if (!frames)
+			continue;
+
+		const auto [frameSlot, isNew] { frameSlots.try_emplace(frames, static_cast<uint32_t>(i)) };
+		if (!isNew)
+			dataSlots[i] = frameSlot->second;
+	}
+
+	std::vector<size_t> sequenceIndices(sequences.size());
+	std::iota(sequenceIndices.begin(), sequenceIndices.end(), size_t{ 0U });
+
+	std::vector<SectionEntry> sectionTable(sequences.size());
+	std::vector<std::string> sections(sequences.size());
+	std::exception_ptr firstException{ nullptr };
+	std::mutex exceptionMutex;
+
+	std::transform(std::execution::par, sequenceIndices.begin(), sequenceIndices.end(), sections.begin(),
+	[storeDerivedData, &sequences, &dataSlots, &sectionTable, &firstException, &exceptionMutex](const size_t sequenceIndex) -> std::string
+	{
+		const ProjectSnapshot::Sequence& sequence{ sequences[sequenceIndex] };
+		SectionEntry& entry{ sectionTable[sequenceIndex] };
+
+		try
+		{
+			BIO_UNLIKELY
+			if (sequence.PendingSequence.has_value())
+			{
+				const std::string& sequenceName{ std::visit([](const auto& metadata) -> const std::string& { return metadata.SequenceName; }, sequence.Metadata) };
+
+				entry.Type = sequence.PendingSequence->SectionType;
+				entry.Flags = sequence.PendingSequence->SectionFlags;
+				return CompressSection(RenameStoredSection(sequence.PendingSequence->Section(), sequenceName));
+			}
+
+			BIO_UNLIKELY
+			if (dataSlots[sequenceIndex] != g_InvalidSlot)
+				return CompressSection(EncodeSharedSection(sequence.Metadata, dataSlots[sequenceIndex], entry));
+
+			return CompressSection(EncodeSection(sequence.Metadata, storeDerivedData, entry));
+		}
+		catch (...)
+		{
+			const std::lock_guard<std::mutex> lock{ exceptionMutex };
+			if (!firstException)
+				firstException = std::current_exception();
+
+			return {};
+		}
+	});
+
+	BIO_UNLIKELY
+	if (firstException)
+		std::rethrow_exception(firstException);
+
+	uint64_t sectionOffset{ sizeof(FileHeader) + sizeof(SectionEntry) * sectionTable.size() };
+	for (size_t i{ 0U }; i < sections.size(); ++i)
+	{
+		sectionTable[i].Offset = sectionOffset;
+		sectionTable[i].Size = sections[i].size();
+		sectionOffset += sections[i].size();
+	}
+
+	const FileHeader header{ .Magic{ g_BinaryMagic }, .Version{ g_BinaryVersion }, .Codec{ Codec_Lz4 }, .SectionCount{ static_cast<uint32_t>(sectionTable.size()) } };
+	output.write(reinterpret_cast<const char*>(&header), sizeof(header));
+	output.write(reinterpret_cast<const char*>(sectionTable.data()), static_cast<std::streamsize>(sizeof(SectionEntry) * sectionTable.size()));
+
+	for (const std::string& section : sections)
+		output.write(section.data(), static_cast<std::streamsize>(section.size()));
+
+	return sectionOffset;
+}
+
+bool ProjectSerializer::OnSerialize(const std::filesystem::path& path, const bool storeDerivedData) const
+{
+	BIO_UNLIKELY
 	if (!m_Project)
 		THROW_EXCEPTION("Saving invalid project");
 
 	try
 	{
-		std::ofstream output(path, std::ios::binary);
+		/* Also releases the mapping of the opened project, which may be the file being replaced */
+		Project::MaterializeSequences();
+
+		const ProjectSnapshot snapshot{ TakeSnapshot() };
+		const uint64_t baseSize{ WriteSnapshot(snapshot, path, storeDerivedData) };
+
+		Project::SavedFile& savedFile{ Project::s_SavedFile };
+		savedFile.Path = path;
+		savedFile.Slots.clear();
+		for (size_t i{ 0U }; i < snapshot.m_Sequences.size(); ++i)
+			savedFile.Slots.emplace(snapshot.m_Sequences[i].UUID, static_cast<uint32_t>(i));
+
+		savedFile.SlotCount = static_cast<uint32_t>(snapshot.m_Sequences.size());
+		savedFile.Codec = Codec_Lz4;
+		savedFile.BaseSize = baseSize;
+		savedFile.JournalSize = 0U;
+		return true;
+	}
+	catch (...)
+	{
+		HandleExceptions();
+		return false;
+	}
+}
+
+ProjectSnapshot ProjectSerializer::TakeSnapshot()
+{
+	ProjectSnapshot snapshot;
+
+	const std::vector<ID> sequences{ Project::s_SequenceRegistry.GetIDsInCreationOrder() };
+	snapshot.m_Sequences.reserve(sequences.size());
+	for (const ID sequenceUUID : sequences)
+	{
+		const auto pendingSequence{ Project::s_PendingSequences.find(sequenceUUID) };
+
+		Project::SequenceTypes metadata{ Project::s_SequenceRegistry.Visit(sequenceUUID, [](const auto& metadata) { return Project::SequenceTypes{ metadata }; }) };
+		ProjectSnapshot::Sequence& sequence{ snapshot.m_Sequences.emplace_back(ProjectSnapshot::Sequence{ sequenceUUID, std::move(metadata), std::nullopt }) };
+		if (pendingSequence != Project::s_PendingSequences.end())
+			sequence.PendingSequence = pendingSequence->second;
+	}
+
+	return snapshot;
+}
+
+uint64_t ProjectSerializer::WriteSnapshot(const ProjectSnapshot& snapshot, const std::filesystem::path& path, const bool storeDerivedData)
+{
+	std::filesystem::path temporaryPath{ path };
+	temporaryPath += ".tmp";
+
+	uint64_t baseSize{ 0U };
+	{
+		std::ofstream output(temporaryPath, std::ios::binary | std::ios::trunc);
 
 		BIO_UNLIKELY
 		if (!output.is_open())
-			return THROW_EXCEPTION("Failed to open file");
+			THROW_EXCEPTION("Failed to open file");
+
+		baseSize = WriteBinary(output, snapshot, storeDerivedData);
+		output.close();
+
+		BIO_UNLIKELY
+		if (output.fail())
+			THROW_EXCEPTION("Failed to write project file");
+	}
+
+	/* Replaces the previous file in one step, an interrupted write only leaves the temporary file behind */
+	std::filesystem::rename(temporaryPath, path);
+	return baseSize;
+}
+
+bool ProjectSerializer::OnSave(const std::filesystem::path& path) const
+{
+	BIO_UNLIKELY
+	if (!m_Project)
+		THROW_EXCEPTION("Saving invalid project");
+
+	const Project::SavedFile& savedFile{ Project::s_SavedFile };
+
+	std::error_code error;
+	const bool canAppend
+	{
+		!savedFile.Path.empty() && std::filesystem::equivalent(path, savedFile.Path, error) &&
+		std::filesystem::file_size(path, error) == savedFile.BaseSize + savedFile.JournalSize && !error
+	};
+
+	BIO_UNLIKELY
+	if (!canAppend)
+		return OnSerialize(path);
 
-		for (const auto& [sequenceUUID, metadata] : Project::Get()->s_SequenceRegistry)
+	try
+	{
+		std::vector<uint32_t> removedSlots;
+		for (const auto& [sequenceUUID, slot] : savedFile.Slots)
+			if (!Project::s_SequenceRegistry.Contains(sequenceUUID))
+				removedSlots.emplace_back(slot);
+
+		std::sort(removedSlots.begin(), removedSlots.end());
+
+		std::vector<ID> addedSequences{ Project::s_SequenceRegistry.GetIDsInCreationOrder() };
+		std::erase_if(addedSequences, [&savedFile](const ID sequenceUUID)
 		{
-			std::visit(overloaded
-			{
-				[&](const DnaMetadata& dnaMetadata)
-				{
-					output << '#' << s_DNASequenceTypeToken << dnaMetadata.SequenceName << std::endl;
+			return savedFile.Slots.contains(sequenceUUID);
+		});
 
-					for (size_t i{ 0U }; i < g_FrameCount; ++i)
-					{
-						output << dnaMetadata.Frames[i].DnaSequence << std::endl;
-						output << dnaMetadata.Frames[i].AminoSequence << std::endl;
+		/* Added duplicates refer to a saved slot (or an earlier added one) with the same frames, decoded ones only */
+		std::unordered_map<const void*, uint32_t> frameSlots;
+		for (const auto& [sequenceUUID, slot] : savedFile.Slots)
+		{
+			if (!Project::s_SequenceRegistry.Contains(sequenceUUID) || Project::s_PendingSequences.contains(sequenceUUID))
+				continue;
 
-						/* TODO: Skip if empty? */
-						output << s_BeginLoopToken << std::endl;
-						for (const auto& candidate : dnaMetadata.Frames[i].ProteinCandidates)
-							output << candidate << std::endl;
+			if (const void* const frames{ Project::s_SequenceRegistry.Visit(sequenceUUID, [](const auto& metadata) { return GetSharedFrames(metadata); }) })
+				frameSlots.emplace(frames, slot);
+		}
 
-						output << s_EndLoopToken << std::endl;
-					}
-				},
-			
-				[&](const RnaMetadata& rnaMetadata)
-				{
-					output << '#' << s_RNASequenceTypeToken << rnaMetadata.SequenceName << std::endl;
+		std::vector<uint32_t> dataSlots(addedSequences.size(), g_InvalidSlot);
+		for (size_t i{ 0U }; i < addedSequences.size(); ++i)
+		{
+			const void* const frames{ Project::s_SequenceRegistry.Visit(addedSequences[i], [](const auto& metadata) { return GetSharedFrames(metadata); }) };
+			if (!frames)
+				continue;
 
-					for (size_t i{ 0U }; i < g_FrameCount; ++i)
-					{
-						output << rnaMetadata.Frames[i].RnaSequence << std::endl;
-						output << rnaMetadata.Frames[i].AminoSequence << std::endl;
+			const auto [frameSlot, isNew] { frameSlots.try_emplace(frames, savedFile.SlotCount + static_cast<uint32_t>(i)) };
+			if (!isNew)
+				dataSlots[i] = frameSlot->second;
+		}
 
-						/* TODO: Skip if empty? */
-						output << s_BeginLoopToken << std::endl;
-						for (const auto& candidate : rnaMetadata.Frames[i].ProteinCandidates)
-							output << candidate << std::endl;
+		std::vector<JournalRecord> addedRecords(addedSequences.size());
+		std::vector<std::string> addedSections(addedSequences.size());
 
-						output << s_EndLoopToken << std::endl;
-					}
-				},
-			
-				[&](const AminoMetadata& aminoMetadata)
+		std::vector<size_t> sequenceIndices(addedSequences.size());
+		std::iota(sequenceIndices.begin(), sequenceIndices.end(), size_t{ 0U });
+
+		std::transform(std::execution::par, sequenceIndices.begin(), sequenceIndices.end(), addedSections.begin(),
+		[codec = savedFile.Codec, &addedSequences, &dataSlots, &addedRecords](const size_t sequenceIndex)
+		{
+			SectionEntry entry{};
+			std::string section
+			{
+				Project::s_SequenceRegistry.Visit(addedSequences[sequenceIndex], [&dataSlots, &entry, sequenceIndex](const auto& sequence)
 				{
-					output << '#' << s_PeptideSequenceTypeToken << aminoMetadata.SequenceName << std::endl;
+					return dataSlots[sequenceIndex] != g_InvalidSlot ?
+						EncodeSharedSection(sequence, dataSlots[sequenceIndex], entry) :
+						EncodeSection(sequence, true, entry);
+				})
+			};
 
-					output << aminoMetadata.AminoSequence << std::endl;
+			if (codec == Codec_Lz4)
+				section = CompressSection(section);
 
-					/* TODO: Skip if empty? */
-					output << s_BeginLoopToken << std::endl;
-					for (const auto& candidate : aminoMetadata.ProteinCandidates)
-						output << candidate << std::endl;
+			addedRecords[sequenceIndex] = JournalRecord{ .Kind{ JournalRecordKind_Add }, .Slot{ 0U }, .Type{ entry.Type }, .Flags{ entry.Flags }, .Size{ section.size() } };
+			return section;
+		});
 
-					output << s_EndLoopToken << std::endl;
-				},
-			
-				[](const auto& arg) { BIO_ASSERT(false); (void)arg; }
-			},
-			metadata);
+		uint64_t journalSize{ sizeof(JournalRecord) * (removedSlots.size() + addedRecords.size()) };
+		for (const std::string& section : addedSections)
+			journalSize += section.size();
+
+		/* Past the threshold the whole project is rewritten, which drops the journal */
+		BIO_UNLIKELY
+		if (savedFile.JournalSize + journalSize > std::max(g_MinimumCompactedJournalSize, savedFile.BaseSize / g_CompactedJournalRatio))
+			return OnSerialize(path);
+
+		std::ofstream output(path, std::ios::binary | std::ios::app);
+
+		BIO_UNLIKELY
+		if (!output.is_open())
+			THROW_EXCEPTION("Failed to open file");
+
+		for (const uint32_t slot : removedSlots)
+		{
+			const JournalRecord record{ .Kind{ JournalRecordKind_Remove }, .Slot{ slot }, .Type{ 0U }, .Flags{ 0U }, .Size{ 0U } };
+			output.write(reinterpret_cast<const char*>(&record), sizeof(record));
+		}
+
+		uint32_t slotCount{ savedFile.SlotCount };
+		for (size_t i{ 0U }; i < addedRecords.size(); ++i)
+		{
+			addedRecords[i].Slot = slotCount++;
+			output.write(reinterpret_cast<const char*>(&addedRecords[i]), sizeof(JournalRecord));
+			output.write(addedSections[i].data(), static_cast<std::streamsize>(addedSections[i].size()));
 		}
 
 		output.close();
+
+		BIO_UNLIKELY
+		if (output.fail())
+			THROW_EXCEPTION("Failed to write project file");
+
+		Project::SavedFile& updatedFile{ Project::s_SavedFile };
+		std::erase_if(updatedFile.Slots, [](const auto& slot)
+		{
+			return !Project::s_SequenceRegistry.Contains(slot.first);
+		});
+
+		for (size_t i{ 0U }; i < addedSequences.size(); ++i)
+			updatedFile.Slots.emplace(addedSequences[i], addedRecords[i].Slot);
+
+		updatedFile.SlotCount = slotCount;
+		updatedFile.JournalSize += journalSize;
+		return true;
 	}
 	catch (...)
 	{
 		HandleExceptions();
+		return false;
 	}
 }
 
@@ -744,122 +2192,340 @@ void ProjectSerializer::OnDeserialize(const std::filesystem::path& path)
 	if (!m_Project)
 		THROW_EXCEPTION("Deserializing into invalid project");
 
-	BIO_LIKELY
-	if (std::filesystem::exists(path))
+	BIO_UNLIKELY
+	if (!std::filesystem::exists(path))
 	{
-		try
+		fprintf(stderr, "Failed loading project (path doesn't exists)\n");
+		return;
+	}
+
+	try
+	{
+		BIO_UNLIKELY
+		if (std::filesystem::is_empty(path))
+			return;
+
+		/* Journaled saves append to the file while its sections are still mapped */
+		const std::shared_ptr<const MappedFile> mappedFile{ std::make_shared<const MappedFile>(path, true) };
+		const std::string_view file{ mappedFile->GetView() };
+
+		if (file.size() >= g_BinaryMagic.size() && std::equal(g_BinaryMagic.begin(), g_BinaryMagic.end(), file.begin()))
 		{
-			std::ifstream input(path, std::ios::binary);
-			
-			BIO_UNLIKELY
-			if (!input.is_open())
-				THROW_EXCEPTION("Failed to open file");
+			DeserializeBinary(mappedFile);
+			Project::s_SavedFile.Path = path;
+		}
+		else
+			DeserializeText(file);
+	}
+	catch (...)
+	{
+		HandleExceptions();
+	}
+}
+
+void ProjectSerializer::DeserializeBinary(const std::shared_ptr<const MappedFile> mappedFile)
+{
+	const std::string_view file{ mappedFile->GetView() };
+	FileHeader header;
 
-			std::string currentLine;
-			while (std::getline(input, currentLine))
+	BIO_UNLIKELY
+	if (file.size() < sizeof(header))
+		THROW_EXCEPTION("Invalid project file");
+
+	std::memcpy(&header, file.data(), sizeof(header));
+
+	BIO_UNLIKELY
+	if (header.Version != g_BinaryVersion)
+		THROW_EXCEPTION("Unsupported project file version");
+
+	BIO_UNLIKELY
+	if (header.Codec != Codec_None && header.Codec != Codec_Lz4)
+		THROW_EXCEPTION("Unsupported project file codec");
+
+	BIO_UNLIKELY
+	if (header.SectionCount > (file.size() - sizeof(header)) / sizeof(SectionEntry))
+		THROW_EXCEPTION("Invalid project file");
+
+	std::vector<SectionEntry> sectionTable(header.SectionCount);
+	std::memcpy(sectionTable.data(), file.data() + sizeof(header), sizeof(SectionEntry) * sectionTable.size());
+
+	/* Removed sections are kept, shared sections added later may still point at them */
+	struct SlotSection
+	{
+		uint32_t Type;
+		uint32_t Flags;
+		std::string_view Section;
+		bool IsRemoved;
+	};
+
+	std::vector<SlotSection> slots;
+	slots.reserve(sectionTable.size());
+
+	uint64_t baseSize{ sizeof(header) + sizeof(SectionEntry) * sectionTable.size() };
+	for (const SectionEntry& entry : sectionTable)
+	{
+		BIO_UNLIKELY
+		if (entry.Offset > file.size() || entry.Size > file.size() - entry.Offset)
+			THROW_EXCEPTION("Invalid project file");
+
+		slots.emplace_back(SlotSection{ entry.Type, entry.Flags, file.substr(static_cast<size_t>(entry.Offset), static_cast<size_t>(entry.Size)), false });
+		baseSize = std::max(baseSize, entry.Offset + entry.Size);
+	}
+
+	/* A record torn by an interrupted save ends the journal, the next save rewrites the file */
+	uint64_t journalEnd{ baseSize };
+	while (file.size() - journalEnd >= sizeof(JournalRecord))
+	{
+		JournalRecord record;
+		std::memcpy(&record, file.data() + journalEnd, sizeof(record));
+
+		const uint64_t sectionBegin{ journalEnd + sizeof(record) };
+		if (record.Kind == JournalRecordKind_Add && record.Slot == slots.size() && record.Size <= file.size() - sectionBegin)
+		{
+			slots.emplace_back(SlotSection{ record.Type, record.Flags, file.substr(static_cast<size_t>(sectionBegin), static_cast<size_t>(record.Size)), false });
+			journalEnd = sectionBegin + record.Size;
+		}
+		else if (record.Kind == JournalRecordKind_Remove && record.Slot < slots.size() && !slots[record.Slot].IsRemoved)
+		{
+			slots[record.Slot].IsRemoved = true;
+			journalEnd = sectionBegin;
+		}
+		else
+			break;
+	}
+
+	Project::SavedFile& savedFile{ Project::s_SavedFile };
+	savedFile.SlotCount = static_cast<uint32_t>(slots.size());
+	savedFile.Codec = header.Codec;
+	savedFile.BaseSize = baseSize;
+	savedFile.JournalSize = journalEnd - baseSize;
+
+	/* Shared sections resolve to the slot holding their data, references only point backwards so one pass settles chains */
+	std::vector<uint32_t> dataSlots(slots.size());
+	for (uint32_t slot{ 0U }; slot < slots.size(); ++slot)
+	{
+		dataSlots[slot] = slot;
+
+		BIO_LIKELY
+		if ((slots[slot].Flags & SectionFlags_SharedData) == 0U)
+			continue;
+
+		std::string buffer;
+		SectionReader reader{ ExpandSection(slots[slot].Section, header.Codec, buffer) };
+		reader.ReadName();
+		const uint32_t dataSlot{ reader.Read<uint32_t>() };
+
+		BIO_UNLIKELY
+		if (dataSlot >= slot || slots[dataSlot].Type != slots[slot].Type || slots[slot].Type == SectionType_Peptide)
+			THROW_EXCEPTION("Invalid shared project section");
+
+		dataSlots[slot] = dataSlots[dataSlot];
+	}
+
+	/* Only names are read here, every pending sequence keeps the mapping alive until it's decoded */
+	for (uint32_t slot{ 0U }; slot < slots.size(); ++slot)
+	{
+		BIO_UNLIKELY
+		if (slots[slot].IsRemoved)
+			continue;
+
+		/* Duplicates decode the data of their shared section, the registry hands them the same frames afterwards */
+		const SlotSection& data{ slots[dataSlots[slot]] };
+		const std::string_view section{ data.Section };
+		const bool hasDerivedData{ (data.Flags & SectionFlags_DerivedData) != 0U };
+		const std::string sequenceName{ SectionReader{ slots[slot].Section }.ReadName() };
+
+		/* Saves write the stored section as it is while the sequence isn't decoded */
+		std::function<std::string()> readSection
+		{
+			[mappedFile, section, codec = header.Codec]()
 			{
-				if (currentLine.empty())
-					THROW_EXCEPTION("Invalid file format");
+				std::string buffer;
+				return std::string{ ExpandSection(section, codec, buffer) };
+			}
+		};
 
-				if (const std::size_t typeTokenPosition = currentLine.find(s_SequenceTypeToken) != std::string::npos)
+		ID sequenceUUID{ g_InvalidID };
+		switch (slots[slot].Type)
+		{
+		case SectionType_Dna:
+			sequenceUUID = Project::RegisterPendingSequence<DnaMetadata>(sequenceName,
+			{
+				.Decode{ [mappedFile, section, hasDerivedData, codec = header.Codec]() -> Project::SequenceTypes
+				{
+					std::string buffer;
+					SectionReader reader{ ExpandSection(section, codec, buffer) };
+					return ReadNucleotideSection<Bio::DnaSequence, DnaMetadata>(reader, hasDerivedData, [](auto& frame) -> Bio::DnaSequence& { return frame.DnaSequence; });
+				} },
+				.Section{ std::move(readSection) }, .SectionType{ data.Type }, .SectionFlags{ data.Flags }
+			});
+			break;
+		case SectionType_Rna:
+			sequenceUUID = Project::RegisterPendingSequence<RnaMetadata>(sequenceName,
+			{
+				.Decode{ [mappedFile, section, hasDerivedData, codec = header.Codec]() -> Project::SequenceTypes
 				{
-					static_assert(
-						sizeof(s_DNASequenceTypeToken) == 
-						sizeof(s_RNASequenceTypeToken) &&
-						sizeof(s_RNASequenceTypeToken) ==
-						sizeof(s_PeptideSequenceTypeToken));
+					std::string buffer;
+					SectionReader reader{ ExpandSection(section, codec, buffer) };
+					return ReadNucleotideSection<Bio::RnaSequence, RnaMetadata>(reader, hasDerivedData, [](auto& frame) -> Bio::RnaSequence& { return frame.RnaSequence; });
+				} },
+				.Section{ std::move(readSection) }, .SectionType{ data.Type }, .SectionFlags{ data.Flags }
+			});
+			break;
+		case SectionType_Peptide:
+			sequenceUUID = Project::RegisterPendingSequence<AminoMetadata>(sequenceName,
+			{
+				.Decode{ [mappedFile, section, hasDerivedData, codec = header.Codec]() -> Project::SequenceTypes
+				{
+					std::string buffer;
+					SectionReader reader{ ExpandSection(section, codec, buffer) };
+					return ReadPeptideSection(reader, hasDerivedData);
+				} },
+				.Section{ std::move(readSection) }, .SectionType{ data.Type }, .SectionFlags{ data.Flags }
+			});
+			break;
+		default:
+			THROW_EXCEPTION("Unknown project section type");
+		}
 
-					const std::string metadataTypeString{ currentLine.substr(typeTokenPosition, 4U) };
-					const std::string sequenceName{ currentLine.substr(currentLine.find(':') + 1U) };
+		savedFile.Slots.emplace(sequenceUUID, slot);
+	}
+}
 
-					if (metadataTypeString == s_DNASequenceTypeToken)
-					{
-						auto& ref{ Project::RegisterSequence<DnaMetadata>("")};
-						DnaMetadata deserialized{ sequenceName };
+Project::SequenceTypes ProjectSerializer::ReadTextSection(const std::string_view section)
+{
+	static_assert(
+		sizeof(s_DNASequenceTypeToken) ==
+		sizeof(s_RNASequenceTypeToken) &&
+		sizeof(s_RNASequenceTypeToken) ==
+		sizeof(s_PeptideSequenceTypeToken));
+
+	size_t position{ 0U };
+	const auto nextLine
+	{
+		[&section, &position]()
+		{
+			BIO_UNLIKELY
+			if (position >= section.size())
+				return std::string_view{};
 
-						for (uint32_t i{ 0U }; i < 3U; ++i)
-						{
-							std::getline(input, currentLine);
-							deserialized.Frames[i].DnaSequence = Bio::ConvertToDNA(currentLine);
+			const size_t lineEnd{ std::min(section.find('\n', position), section.size()) };
+			const std::string_view line{ section.substr(position, lineEnd - position) };
+			position = lineEnd + 1U;
+			return line;
+		}
+	};
 
-							std::getline(input, currentLine);
-							deserialized.Frames[i].AminoSequence = Bio::ConvertToAminoSequence(currentLine);
+	const auto readProteinCandidates
+	{
+		[&nextLine]()
+		{
+			std::vector<Bio::AminoSequence> proteinCandidates;
+			if (nextLine().find(s_BeginLoopToken) != std::string_view::npos)
+				for (std::string_view line{ nextLine() }; !line.empty() && line.find(s_EndLoopToken) == std::string_view::npos; line = nextLine())
+					proteinCandidates.emplace_back(Bio::EncodeAminoSequence(line));
 
-							std::vector<Bio::AminoSequence> proteinCandidates;
-							if (std::getline(input, currentLine) && currentLine.find(s_BeginLoopToken) != std::string::npos)
-							{
-								std::getline(input, currentLine);
-								while (currentLine.find(s_EndLoopToken) == std::string::npos)
-								{
-									proteinCandidates.emplace_back(Bio::ConvertToAminoSequence(currentLine));
-									std::getline(input, currentLine);
-								}
-							}
+			return proteinCandidates;
+		}
+	};
 
-							deserialized.Frames[i].ProteinCandidates = std::move(proteinCandidates);
-						}
+	const auto readFrames
+	{
+		[&nextLine, &readProteinCandidates](auto& metadata, const auto& encode, const auto& getSequence)
+		{
+			const auto frames{ std::make_shared<typename std::decay_t<decltype(metadata)>::FrameArray>() };
+			for (auto& frame : *frames)
+			{
+				auto& sequence{ getSequence(frame) };
+				sequence = encode(nextLine());
 
-						ref = std::move(deserialized);
-					}
-					else if (metadataTypeString == s_RNASequenceTypeToken)
-					{
-						auto& ref{ Project::RegisterSequence<RnaMetadata>("") };
-						RnaMetadata deserialized{ sequenceName };
+				/* The stored translation is redone by the scan, which also finds the starts the candidates are reselected from */
+				nextLine();
+				ScanNucleotideFrame(frame, sequence);
 
-						for (uint32_t i{ 0U }; i < g_FrameCount; ++i)
-						{
-							std::getline(input, currentLine);
-							deserialized.Frames[i].RnaSequence = Bio::ConvertToRNA(currentLine);
+				std::vector<Bio::AminoSequence> proteinCandidates{ readProteinCandidates() };
+				frame.OpenReadingFrames = Bio::LocateOpenReadingFrames(frame.AminoSequence, proteinCandidates);
+				frame.ProteinCandidates = std::move(proteinCandidates);
+				frame.CodonUsages = Bio::CountCodonUsages(sequence, frame.OpenReadingFrames);
 
-							std::getline(input, currentLine);
-							deserialized.Frames[i].AminoSequence = Bio::ConvertToAminoSequence(currentLine);
+				/* Scores aren't stored in the project file */
+				frame.CodingPotentials = Bio::CalculateCodingPotentials(sequence, frame.OpenReadingFrames, Project::GetHexamerTable());
+			}
 
-							std::vector<Bio::AminoSequence> proteinCandidates;
-							if (std::getline(input, currentLine) && currentLine.find(s_BeginLoopToken) != std::string::npos)
-							{
-								std::getline(input, currentLine);
-								while (currentLine.find(s_EndLoopToken) == std::string::npos)
-								{
-									proteinCandidates.emplace_back(Bio::ConvertToAminoSequence(currentLine));
-									std::getline(input, currentLine);
-								}
-							}
+			metadata.ContentHash = Bio::HashSequence(getSequence((*frames)[0U]));
+			metadata.Frames = frames;
+		}
+	};
 
-							deserialized.Frames[i].ProteinCandidates = std::move(proteinCandidates);
-						}
+	const std::string_view header{ nextLine() };
+	const std::string_view metadataType{ header.substr(1U, 4U) };
+	const std::string sequenceName{ header.substr(std::min(header.find(':') + 1U, header.size())) };
 
-						ref = std::move(deserialized);
-					}
-					else if (metadataTypeString == s_PeptideSequenceTypeToken)
-					{
-						auto& ref{ Project::RegisterSequence<AminoMetadata>("") };
-						AminoMetadata deserialized{ sequenceName };
+	if (metadataType == s_DNASequenceTypeToken)
+	{
+		DnaMetadata metadata{ sequenceName };
+		readFrames(metadata, [](const std::string_view line) { return Bio::EncodeDNA(line); }, [](auto& frame) -> Bio::DnaSequence& { return frame.DnaSequence; });
+		return metadata;
+	}
 
-						std::getline(input, currentLine);
-						deserialized.AminoSequence = Bio::ConvertToAminoSequence(currentLine);
+	if (metadataType == s_RNASequenceTypeToken)
+	{
+		RnaMetadata metadata{ sequenceName };
+		readFrames(metadata, [](const std::string_view line) { return Bio::EncodeRNA(line); }, [](auto& frame) -> Bio::RnaSequence& { return frame.RnaSequence; });
+		return metadata;
+	}
 
-						std::vector<Bio::AminoSequence> proteinCandidates;
-						if (std::getline(input, currentLine) && currentLine.find(s_BeginLoopToken) != std::string::npos)
-						{
-							std::getline(input, currentLine);
-							while (currentLine.find(s_EndLoopToken) == std::string::npos)
-							{
-								proteinCandidates.emplace_back(Bio::ConvertToAminoSequence(currentLine));
-								std::getline(input, currentLine);
-							}
-						}
+	BIO_UNLIKELY
+	if (metadataType != s_PeptideSequenceTypeToken)
+		THROW_EXCEPTION("Invalid file format");
+
+	AminoMetadata metadata{ sequenceName };
+	metadata.AminoSequence = Bio::EncodeAminoSequence(nextLine());
+	metadata.OpenReadingFrameStarts = Bio::ScanOpenReadingFrameStarts(metadata.AminoSequence);
+	metadata.ProteinCandidates = readProteinCandidates();
+	return metadata;
+}
 
-						deserialized.ProteinCandidates = std::move(proteinCandidates);
-						ref = std::move(deserialized);
-					}
-				}
-			}
+void ProjectSerializer::DeserializeText(const std::string_view file)
+{
+	/* Sections begin at the lines carrying a type token, splitting is a serial scan, decoding runs in parallel */
+	std::vector<std::string_view> sections;
+	size_t sectionBegin{ file.size() };
+	for (size_t lineBegin{ 0U }; lineBegin < file.size(); lineBegin = std::min(file.find('\n', lineBegin), file.size()) + 1U)
+	{
+		if (file[lineBegin] != s_SequenceTypeToken)
+			continue;
+
+		if (sectionBegin < lineBegin)
+			sections.emplace_back(file.substr(sectionBegin, lineBegin - sectionBegin));
+
+		sectionBegin = lineBegin;
+	}
+
+	if (sectionBegin < file.size())
+		sections.emplace_back(file.substr(sectionBegin));
+
+	std::vector<std::optional<Project::SequenceTypes>> sequences(sections.size());
+	std::transform(std::execution::par, sections.begin(), sections.end(), sequences.begin(), [](const std::string_view section) -> std::optional<Project::SequenceTypes>
+	{
+		try
+		{
+			return ReadTextSection(section);
 		}
 		catch (...)
 		{
 			HandleExceptions();
+			return std::nullopt;
+		}
+	});
+
+	/* Registered in file order so IDs come out the same on every load */
+	for (std::optional<Project::SequenceTypes>& sequence : sequences)
+	{
+		BIO_LIKELY
+		if (sequence.has_value())
+		{
+			std::visit([](auto& metadata) { Project::RegisterSequence(std::move(metadata)); }, *sequence);
 		}
 	}
-	else
-		fprintf(stderr, "Failed saving project (path doesn't exists)\n");
 }
\ No newline at end of file
@@ -0,0 +1,51 @@
+#include "SequenceFile.hpp"
+
+SequenceFile::SequenceFile(const std::filesystem::path& path)
+	:
+	m_File(path),
+	m_CompressedFile(nullptr),
+	m_Path(path)
+{
+	if (GzipFile::IsCompressed(m_File.GetView()))
+		m_CompressedFile = std::make_unique<GzipFile>(m_File.GetView());
+}
+
+bool SequenceFile::HasExtension(const std::filesystem::path& path, const std::initializer_list<std::string_view> extensions)
+{
+	std::filesystem::path uncompressedPath{ path };
+	if (uncompressedPath.extension() == ".gz")
+		uncompressedPath.replace_extension();
+
+	std::string extension{ uncompressedPath.extension().string() };
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](const char character)
+	{
+		return static_cast<char>(std::tolower(character));
+	});
+
+	return std::find(extensions.begin(), extensions.end(), extension) != extensions.end();
+}
+
+FileWindow::FileWindow(const SequenceFile& file)
+	:
+	m_File(file),
+	m_Stream(nullptr),
+	m_Buffer(),
+	m_Offset(0U),
+	m_Consumed(0U)
+{
+	if (const GzipFile* const compressedFile = file.GetCompressedFile())
+		m_Stream = std::make_unique<GzipFile::Stream>(*compressedFile);
+}
+
+bool FileWindow::Extend()
+{
+	if (IsAtEnd())
+		return false;
+
+	m_Buffer.erase(0U, m_Consumed);
+	m_Offset += m_Consumed;
+	m_Consumed = 0U;
+
+	m_Stream->Read(m_Buffer, s_ChunkSize);
+	return true;
+}
\ No newline at end of file
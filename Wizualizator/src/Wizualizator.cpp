@@ -7,6 +7,9 @@
 #include "Panels/PlotPanel.hpp"
 #include "Panels/StructurePanel.hpp"
 #include "FastaReader.hpp"
+#include "ImportJob.hpp"
+#include "AutosaveJob.hpp"
+#include "DerivedDataCache.hpp"
 
 #include "imgui.h"
 #include "imgui_internal.h"
@@ -15,11 +18,39 @@
 #include "Platform.hpp"
 #include "Window.hpp"
 
+/* Whole file on a worker thread, records are parsed and created on all cores a batch at a time */
+template<typename SequenceMetadataType>
+static void LaunchFastaImport(const std::filesystem::path& path)
+{
+	ImportJob::Launch(path.filename().string(), [path, settings = Project::GetFrameSettings()](ImportJob& job)
+	{
+		const FastaReader reader(path);
+		job.AddTotalBytes(reader.GetSize());
+
+		reader.ReadRecords([&job, &settings](const std::span<const FastaRecord> records)
+		{
+			job.CreateSequences<SequenceMetadataType>
+			(
+				records,
+				[&settings](const FastaRecord& record)
+				{
+					return SequenceMetadataType::Create(std::string{ record.Name }, record.Residues(), settings);
+				},
+				[](const FastaRecord& record)
+				{
+					return record.Name.size() + record.Content.size();
+				}
+			);
+		}, job.GetStopToken());
+	});
+}
+
 Wizualizator::Wizualizator(CommandLineArguments&& arguments)
 	:
 	Application(std::move(arguments), VanillaWindowName, 1280U, 960U, true),
 	m_Panels{ new ProjectPanel(), new ContentPanel(), new PropertiesPanel(), new PlotPanel(), new StructurePanel() },
-	m_CurrentProjectDirectory{}
+	m_CurrentProjectDirectory{},
+	m_CurrentProjectPath{}
 {
 	Project::Create();
 	Project::SetPathCallback
@@ -29,6 +60,23 @@ Wizualizator::Wizualizator(CommandLineArguments&& arguments)
 			return m_CurrentProjectDirectory;
 		}
 	);
+
+	/* An untitled project is only ever left in the autosave when a session ended without saving it */
+	try
+	{
+		const std::filesystem::path autosavePath{ AutosaveJob::GetPath({}) };
+		if (std::filesystem::exists(autosavePath))
+		{
+			if (Platform::PushConfirmationWindow("Recover Project", "An untitled project was autosaved before the last session ended. Recover it?"))
+				RecoverAutosave(autosavePath);
+			else
+				AutosaveJob::Discard({});
+		}
+	}
+	catch (...)
+	{
+		HandleExceptions();
+	}
 }
 
 Wizualizator::~Wizualizator() noexcept
@@ -37,6 +85,8 @@ Wizualizator::~Wizualizator() noexcept
 		delete panel;
 
 	m_Panels.clear();
+	ImportJob::CancelAll();
+	AutosaveJob::Wait();
 	Project::Reset();
 }
 
@@ -44,6 +94,10 @@ void Wizualizator::OnGUIRender()
 {
 	static bool f_OpenAboutPopup{ false };
 
+	/* Sequences finished by the import workers since the last frame */
+	ImportJob::Update();
+	AutosaveJob::Update(m_CurrentProjectPath);
+
 	BIO_UNLIKELY
 	if (ImGui::BeginMenuBar())
 	{
@@ -56,14 +110,20 @@ void Wizualizator::OnGUIRender()
 				{
 					if (Platform::PushConfirmationWindow("New Project", "You are about to create a new project. Any unsaved changes will be lost. Proceed?"))
 					{
+						ImportJob::CancelAll();
+						AutosaveJob::Discard(m_CurrentProjectPath);
+						DerivedDataCache::Close();
 						Project::Reset();
 						SetWindowAppendix({});
 					}
 
 					m_CurrentProjectDirectory.clear();
+					m_CurrentProjectPath.clear();
 				}
 				else
 				{
+					ImportJob::CancelAll();
+					DerivedDataCache::Close();
 					Project::Reset();
 					SetWindowAppendix({});
 				}
@@ -80,8 +140,8 @@ void Wizualizator::OnGUIRender()
 
 			if (ImGui::MenuItem("Save"))
 			{
-				if (!m_CurrentProjectDirectory.empty() && std::filesystem::exists(m_CurrentProjectDirectory))
-					SaveAs(m_CurrentProjectDirectory);
+				if (!m_CurrentProjectPath.empty() && std::filesystem::exists(m_CurrentProjectPath))
+					SaveAs(m_CurrentProjectPath);
 				else
 				{
 					const std::optional<std::filesystem::path> openedFile{ Platform::SaveFile(VisualizerProjectFilter) };
@@ -116,31 +176,44 @@ void Wizualizator::OnGUIRender()
 			{
 				const std::optional<std::filesystem::path> openedFile{ Platform::OpenFile(FastaFormatFilter) };
 
+				BIO_LIKELY
+				if (openedFile.has_value())
+				{
+					BIO_LIKELY
+					if (Project::Get())
+						LaunchFastaImport<DnaMetadata>(openedFile.value());
+					else
+						LOG("Cant open a file in an invalid project");
+				}
+			}
+
+			if (ImGui::MenuItem("Import RNA"))
+			{
+				const std::optional<std::filesystem::path> openedFile{ Platform::OpenFile(FastaFormatFilter) };
+
+				BIO_LIKELY
+				if (openedFile.has_value())
+				{
+					BIO_LIKELY
+					if (Project::Get())
+						LaunchFastaImport<RnaMetadata>(openedFile.value());
+					else
+						LOG("Cant open a file in an invalid project");
+				}
+			}
+
+			ImGui::Separator();
+
+			if (ImGui::MenuItem("Load hexamer table"))
+			{
+				const std::optional<std::filesystem::path> openedFile{ Platform::OpenFile(HexamerTableFilter) };
+
 				BIO_LIKELY
 				if (openedFile.has_value())
 				{
 					try
 					{
-						const size_t fileSize{ std::filesystem::file_size(openedFile.value()) };
-						if ((fileSize / 1000U / 1000U) > 100U)
-							if (!Platform::PushConfirmationWindow("Import file", "The file has a size of greater than 100MB and is considered a large file. Importing the file will probably slow down the use of the program significantly. Proceed anyway?"))
-								goto breakOfImporting;
-						
-						const FastaReader reader(openedFile.value());
-						const auto parsedDNA{ reader.ReadNucleotideSequences() };
-						
-						BIO_LIKELY
-						if (Project::Get())
-						{
-							for (const auto& [sequenceName, sequenceContent] : parsedDNA)
-							{
-								auto& ref{ Project::Get()->RegisterSequence<DnaMetadata>(sequenceName) };
-								auto metadata{ DnaMetadata::Create(sequenceName, sequenceContent) };
-								ref = std::move(metadata);
-							}
-						}
-						else
-							LOG("Cant open a file in an invalid project");
+						Project::LoadHexamerTable(openedFile.value());
 					}
 					catch (...)
 					{
@@ -149,44 +222,94 @@ void Wizualizator::OnGUIRender()
 				}
 			}
 
-			if (ImGui::MenuItem("Import RNA"))
+			if (ImGui::MenuItem("Rescore coding potential", nullptr, false, Project::GetHexamerTable() != nullptr))
+				Project::RecalculateCodingPotentials();
+
+			ImGui::Separator();
+
+			if (ImGui::MenuItem("Load codon usage reference"))
 			{
-				const std::optional<std::filesystem::path> openedFile{ Platform::OpenFile(FastaFormatFilter) };
+				const std::optional<std::filesystem::path> openedFile{ Platform::OpenFile(CodonUsageTableFilter) };
 
 				BIO_LIKELY
 				if (openedFile.has_value())
 				{
 					try
 					{
-						const size_t fileSize{ std::filesystem::file_size(openedFile.value()) };
-						if ((fileSize / 1000U / 1000U) > 100U)
-							if (!Platform::PushConfirmationWindow("Import file", "The file has a size of greater than 100MB and is considered a large file. Importing the file will probably slow down the use of the program significantly. Proceed anyway?"))
-								goto breakOfImporting;
+						Project::LoadCodonAdaptationTable(openedFile.value());
+					}
+					catch (...)
+					{
+						HandleExceptions();
+					}
+				}
+			}
 
-						const FastaReader reader(openedFile.value());
-						const auto parsedRNA{ reader.ReadNucleotideSequences() };
+			if (ImGui::MenuItem("Use coding ORFs as codon usage reference"))
+				Project::SetCodonAdaptationReference(Project::CalculateCodonUsage(true));
 
-						BIO_LIKELY
-						if (Project::Get())
+			ImGui::Separator();
+
+			const auto exportProteinCandidates
+			{
+				[](const Project::ProteinExportFilter& filter)
+				{
+					std::optional<std::filesystem::path> savedFile{ Platform::SaveFile(ProteinFastaFilter) };
+
+					BIO_LIKELY
+					if (savedFile.has_value())
+					{
+						if (!savedFile->has_extension())
+							savedFile->replace_extension(".faa");
+
+						try
 						{
-							for (const auto& [sequenceName, sequenceContent] : parsedRNA)
-							{
-								auto& ref{ Project::Get()->RegisterSequence<RnaMetadata>(sequenceName) };
-								auto metadata{ RnaMetadata::Create(sequenceName, sequenceContent) };
-								ref = std::move(metadata);
-							}
+							Project::ExportProteinCandidates(savedFile.value(), filter);
+						}
+						catch (...)
+						{
+							HandleExceptions();
 						}
-						else
-							LOG("Cant open a file in an invalid project");
 					}
-					catch (...)
+				}
+			};
+
+			if (ImGui::MenuItem("Export protein candidates"))
+				exportProteinCandidates({});
+
+			if (ImGui::MenuItem("Export coding protein candidates"))
+				exportProteinCandidates({ .MinimumCodingPotential{ Bio::g_FickettCodingThreshold } });
+
+			const auto exportProperties
+			{
+				[](const std::string_view filter, const char* const extension, const Project::EPropertyExportFormat format)
+				{
+					std::optional<std::filesystem::path> savedFile{ Platform::SaveFile(filter) };
+
+					BIO_LIKELY
+					if (savedFile.has_value())
 					{
-						HandleExceptions();
+						if (!savedFile->has_extension())
+							savedFile->replace_extension(extension);
+
+						try
+						{
+							Project::ExportProperties(savedFile.value(), format);
+						}
+						catch (...)
+						{
+							HandleExceptions();
+						}
 					}
 				}
-			}
+			};
+
+			if (ImGui::MenuItem("Export properties (TSV)"))
+				exportProperties(PropertyTableFilter, ".tsv", Project::EPropertyExportFormat::Tsv);
+
+			if (ImGui::MenuItem("Export properties (JSON Lines)"))
+				exportProperties(PropertyJsonFilter, ".jsonl", Project::EPropertyExportFormat::JsonLines);
 
-			breakOfImporting:
 			ImGui::EndMenu();
 		}
 
@@ -217,6 +340,39 @@ void Wizualizator::OnGUIRender()
 			f_OpenAboutPopup = true;
 			ImGui::EndMenu();
 		}
+
+		for (const std::unique_ptr<ImportJob>& job : ImportJob::GetJobs())
+		{
+			const std::string label
+			{
+				job->GetName() + ": " + std::to_string(job->GetProcessedRecords()) + " records, " +
+				std::to_string(job->GetProcessedBytes() / 1000U / 1000U) + " / " + std::to_string(job->GetTotalBytes() / 1000U / 1000U) + " MB"
+			};
+
+			ImGui::ProgressBar(job->GetProgress(), { 300.0f, 0.0f }, label.c_str());
+
+			/* Batches list the files being imported and the ones that failed so far */
+			if (!job->GetFiles().empty() && ImGui::IsItemHovered())
+			{
+				ImGui::BeginTooltip();
+				for (const ImportJob::FileProgress& file : job->GetFiles())
+				{
+					const ImportJob::EFileState state{ file.State };
+					if (state == ImportJob::EFileState::Importing)
+						GUI::Text(file.Path.filename().string() + ": importing");
+					else if (state == ImportJob::EFileState::Failed)
+						GUI::Text(file.Path.filename().string() + ": failed");
+				}
+				ImGui::EndTooltip();
+			}
+
+			ImGui::PushID(job.get());
+			ImGui::BeginDisabled(job->IsCancelled());
+			if (ImGui::SmallButton("Cancel"))
+				job->Cancel();
+			ImGui::EndDisabled();
+			ImGui::PopID();
+		}
 		
 		ImGui::EndMenuBar();
 	}
@@ -295,12 +451,31 @@ void Wizualizator::OpenProject(const std::filesystem::path& path)
 
 	try
 	{
+		ImportJob::CancelAll();
+		AutosaveJob::Wait();
 		Project::Reset();
-		ProjectSerializer serializer(Project::Get());
-		serializer.OnDeserialize(path);
-		
+		DerivedDataCache::Open(path);
+
+		/* An autosave newer than the project holds changes the last session didn't save */
+		const std::filesystem::path autosavePath{ AutosaveJob::GetPath(path) };
+		std::error_code error;
+		const bool hasNewerAutosave
+		{
+			std::filesystem::exists(autosavePath, error) &&
+			std::filesystem::last_write_time(autosavePath, error) > std::filesystem::last_write_time(path, error)
+		};
+
+		if (hasNewerAutosave && Platform::PushConfirmationWindow("Recover Project", "This project has newer autosaved changes. Open them instead?"))
+			RecoverAutosave(autosavePath);
+		else
+		{
+			ProjectSerializer serializer(Project::Get());
+			serializer.OnDeserialize(path);
+			Project::SetSaveStatus(true);
+		}
+
 		m_CurrentProjectDirectory = path.parent_path();
-		Project::SetSaveStatus(true);
+		m_CurrentProjectPath = path;
 		SetWindowAppendix(path.filename().string());
 	}
 	catch (...)
@@ -316,10 +491,21 @@ void Wizualizator::SaveAs(const std::filesystem::path& path)
 {
 	try
 	{
+		AutosaveJob::Wait();
 		ProjectSerializer serializer(Project::Get());
-		serializer.OnSerialize(path);
+
+		/* The autosaves are only dropped once the project is on disk */
+		BIO_UNLIKELY
+		if (!serializer.OnSave(path))
+			return;
+
+		DerivedDataCache::Save(path, Project::GetDerivedDataHashes());
+
+		AutosaveJob::Discard(m_CurrentProjectPath);
+		AutosaveJob::Discard(path);
 
 		m_CurrentProjectDirectory = path.parent_path();
+		m_CurrentProjectPath = path;
 		Project::SetSaveStatus(true);
 		SetWindowAppendix(path.filename().string());
 	}
@@ -332,6 +518,17 @@ void Wizualizator::SaveAs(const std::filesystem::path& path)
 	}
 }
 
+void Wizualizator::RecoverAutosave(const std::filesystem::path& autosavePath)
+{
+	ProjectSerializer serializer(Project::Get());
+	serializer.OnDeserialize(autosavePath);
+
+	/* Decoded right away, the mapping would keep the next autosave from replacing the file, saves never append to it */
+	Project::MaterializeSequences();
+	Project::s_SavedFile.Clear();
+	Project::SetSaveStatus(false);
+}
+
 void Wizualizator::SetWindowAppendix(const std::string& appendix)
 {
 	if (appendix.empty())
@@ -174,9 +174,12 @@ project("Testy")
 	{ 
 		"%{prj.name}/include/*.hpp",
 		"%{prj.name}/src/*.cpp",
+
+		"%{wks.location}/BioInformatyka/src/Lz4.cpp",
 	}
 
 	includedirs
 	{
 		"%{wks.location}/Wizualizator/include/framework",
+		"%{wks.location}/BioInformatyka/include",
 	}
\ No newline at end of file